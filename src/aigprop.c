@@ -903,7 +903,6 @@ move (AIGProp *aprop, uint32_t nmoves)
 
 /*------------------------------------------------------------------------*/
 
-// TODO termination callback?
 int32_t
 aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
 {
@@ -1017,6 +1016,7 @@ aigprop_sat (AIGProp *aprop, BtorIntHashTable *roots)
          !aprop->use_restarts || j < max_steps;
          j++)
     {
+      if (btor_terminate (aprop->amgr->btor)) goto DONE;
       if (!(move (aprop, nmoves))) goto UNSAT;
       nmoves += 1;
       if (!aprop->unsatroots->count) goto SAT;
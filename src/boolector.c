@@ -394,6 +394,18 @@ boolector_print_stats (Btor *btor)
 #endif
 }
 
+void
+boolector_print_rewrite_profile (Btor *btor, FILE *file)
+{
+  BTOR_ABORT_ARG_NULL (btor);
+  BTOR_TRAPI ("");
+  BTOR_ABORT_ARG_NULL (file);
+  btor_rewrite_dump_profile_json (btor, file);
+#ifndef NDEBUG
+  BTOR_CHKCLONE_NORES (print_rewrite_profile, file);
+#endif
+}
+
 void
 boolector_set_trapi (Btor *btor, FILE *apitrace)
 {
@@ -426,6 +438,8 @@ boolector_push (Btor *btor, uint32_t level)
   {
     BTOR_PUSH_STACK (btor->assertions_trail,
                      BTOR_COUNT_STACK (btor->assertions));
+    /* activation literals are created on demand */
+    BTOR_PUSH_STACK (btor->assertions_actlits, 0);
   }
   btor->num_push_pop++;
 }
@@ -448,7 +462,13 @@ boolector_pop (Btor *btor, uint32_t level)
   BtorNode *cur;
 
   for (i = 0, pos = 0; i < level; i++)
+  {
     pos = BTOR_POP_STACK (btor->assertions_trail);
+    cur = BTOR_POP_STACK (btor->assertions_actlits);
+    /* all assertions guarded by the literal are disabled on the next call
+     * to boolector_sat */
+    if (cur) BTOR_PUSH_STACK (btor->retired_actlits, cur);
+  }
 
   while (BTOR_COUNT_STACK (btor->assertions) > pos)
   {
@@ -480,9 +500,29 @@ boolector_assert (Btor *btor, BoolectorNode *node)
   BTOR_ABORT (btor_node_real_addr (exp)->parameterized,
               "assertion must not be parameterized");
 
-  /* all assertions at a context level > 0 are internally handled as
+  /* all assertions at a context level > 0 are either guarded by the
+   * activation literal of the current level, or internally handled as
    * assumptions. */
-  if (BTOR_COUNT_STACK (btor->assertions_trail) > 0)
+  if (BTOR_COUNT_STACK (btor->assertions_trail) > 0
+      && btor_opt_get (btor, BTOR_OPT_ACTLIT_SCOPES))
+  {
+    uint32_t level;
+    BtorSortId sort;
+    BtorNode *actlit, *guarded;
+    level  = BTOR_COUNT_STACK (btor->assertions_actlits) - 1;
+    actlit = BTOR_PEEK_STACK (btor->assertions_actlits, level);
+    if (!actlit)
+    {
+      sort   = btor_sort_bool (btor);
+      actlit = btor_exp_var (btor, sort, 0);
+      btor_sort_release (btor, sort);
+      BTOR_POKE_STACK (btor->assertions_actlits, level, actlit);
+    }
+    guarded = btor_exp_implies (btor, actlit, exp);
+    btor_assert_exp (btor, guarded);
+    btor_node_release (btor, guarded);
+  }
+  else if (BTOR_COUNT_STACK (btor->assertions_trail) > 0)
   {
     int32_t id = btor_node_get_id (exp);
     if (!btor_hashint_table_contains (btor->assertions_cache, id))
@@ -759,7 +799,8 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
       BTOR_ABORT (btor->btor_sat_btor_called > 0,
                   "enabling/disabling incremental usage must be done "
                   "before calling 'boolector_sat'");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_UCOPT),
+      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_UCOPT)
+                      && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL_SIMP),
                   "incremental solving cannot be enabled "
                   "if unconstrained optimization is enabled");
     }
@@ -768,7 +809,8 @@ boolector_set_opt (Btor *btor, BtorOption opt, uint32_t val)
       BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_MODEL_GEN),
                   "Unconstrained optimization cannot be enabled "
                   "if model generation is enabled");
-      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_INCREMENTAL),
+      BTOR_ABORT (btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+                      && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL_SIMP),
                   "Unconstrained optimization cannot be enabled "
                   "in incremental mode");
     }
@@ -181,6 +181,16 @@ void boolector_reset_stats (Btor *btor);
 */
 void boolector_print_stats (Btor *btor);
 
+/*!
+  Print rewrite rule profile in JSON format.
+
+  The profile is only collected if option BTOR_OPT_REWRITE_PROFILE is enabled.
+
+  :param btor: Boolector instance.
+  :param file: Output file.
+*/
+void boolector_print_rewrite_profile (Btor *btor, FILE *file);
+
 /*!
   Set the output API trace file and enable API tracing.
 
@@ -120,6 +120,9 @@ delete_aig_node (BtorAIGMgr *amgr, BtorAIG *aig)
   assert (!BTOR_IS_INVERTED_AIG (aig));
   assert (amgr);
   if (btor_aig_is_const (aig)) return;
+  /* the CNF id of an AIG may have been released before if the AIG was
+   * only referenced within the cone it was encoded with */
+  if (aig->encoded) amgr->cur_num_dead_cnf_vars++;
   if (aig->cnf_id) release_cnf_id_aig_mgr (amgr, aig);
   amgr->id2aig.start[aig->id] = 0;
   if (aig->is_var)
@@ -889,13 +892,14 @@ btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr)
   res->smgr = btor_sat_mgr_clone (btor, amgr->smgr);
   /* Note: we do not yet clone aigs here (we need the clone of the aig
    *       manager for that). */
-  res->max_num_aigs     = amgr->max_num_aigs;
-  res->max_num_aig_vars = amgr->max_num_aig_vars;
-  res->cur_num_aigs     = amgr->cur_num_aigs;
-  res->cur_num_aig_vars = amgr->cur_num_aig_vars;
-  res->num_cnf_vars     = amgr->num_cnf_vars;
-  res->num_cnf_clauses  = amgr->num_cnf_clauses;
-  res->num_cnf_literals = amgr->num_cnf_literals;
+  res->max_num_aigs          = amgr->max_num_aigs;
+  res->max_num_aig_vars      = amgr->max_num_aig_vars;
+  res->cur_num_aigs          = amgr->cur_num_aigs;
+  res->cur_num_aig_vars      = amgr->cur_num_aig_vars;
+  res->cur_num_dead_cnf_vars = amgr->cur_num_dead_cnf_vars;
+  res->num_cnf_vars          = amgr->num_cnf_vars;
+  res->num_cnf_clauses       = amgr->num_cnf_clauses;
+  res->num_cnf_literals      = amgr->num_cnf_literals;
   clone_aigs (amgr, res);
   return res;
 }
@@ -915,6 +919,26 @@ btor_aig_mgr_delete (BtorAIGMgr *amgr)
   BTOR_DELETE (mm, amgr);
 }
 
+void
+btor_aig_mgr_reset_cnf (BtorAIGMgr *amgr)
+{
+  assert (amgr);
+
+  size_t i;
+  BtorAIG *aig;
+
+  for (i = 2; i < BTOR_COUNT_STACK (amgr->id2aig); i++)
+  {
+    aig = BTOR_PEEK_STACK (amgr->id2aig, i);
+    if (!aig) continue;
+    aig->cnf_id  = 0;
+    aig->encoded = 0;
+  }
+  BTOR_RELEASE_STACK (amgr->cnfid2aig);
+  BTOR_INIT_STACK (amgr->btor->mm, amgr->cnfid2aig);
+  amgr->cur_num_dead_cnf_vars = 0;
+}
+
 static bool
 is_xor_aig (BtorAIGMgr *amgr, BtorAIG *aig, BtorAIGPtrStack *leafs)
 {
@@ -1046,6 +1070,7 @@ set_next_id_aig_mgr (BtorAIGMgr *amgr, BtorAIG *root)
   BTOR_FIT_STACK (amgr->cnfid2aig, (size_t) root->cnf_id);
   amgr->cnfid2aig.start[root->cnf_id] = root->id;
   assert (amgr->cnfid2aig.start[root->cnf_id] == root->id);
+  root->encoded = 1;
   amgr->num_cnf_vars++;
 }
 
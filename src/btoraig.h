@@ -34,6 +34,7 @@ struct BtorAIG
   int32_t next; /* next AIG id for unique table */
   uint8_t mark : 2;
   uint8_t is_var : 1; /* is it an AIG variable or an AND? */
+  uint8_t encoded : 1; /* has it been translated to CNF? */
   uint32_t local;
   int32_t children[]; /* only allocated for AIG AND */
 };
@@ -59,8 +60,9 @@ struct BtorAIGMgr
   BtorAIGPtrStack id2aig; /* id to AIG node */
   BtorIntStack cnfid2aig; /* cnf id to AIG id */
 
-  uint_least64_t cur_num_aigs;     /* current number of ANDs */
-  uint_least64_t cur_num_aig_vars; /* current number of AIG variables */
+  uint_least64_t cur_num_aigs;          /* current number of ANDs */
+  uint_least64_t cur_num_aig_vars;      /* current number of AIG variables */
+  uint_least64_t cur_num_dead_cnf_vars; /* CNF ids of deleted AIGs */
 
   /* statistics */
   uint_least64_t max_num_aigs;
@@ -170,6 +172,10 @@ BtorAIGMgr *btor_aig_mgr_new (Btor *btor);
 BtorAIGMgr *btor_aig_mgr_clone (Btor *btor, BtorAIGMgr *amgr);
 void btor_aig_mgr_delete (BtorAIGMgr *amgr);
 
+/* Drop the CNF encoding of all AIGs, e.g., after the SAT solver has been
+ * reset.  AIGs get new CNF ids when they are translated to SAT again. */
+void btor_aig_mgr_reset_cnf (BtorAIGMgr *amgr);
+
 BtorSATMgr *btor_aig_get_sat_mgr (const BtorAIGMgr *amgr);
 
 /* Variable representing 1 bit. */
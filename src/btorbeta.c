@@ -21,15 +21,110 @@
 #define BETA_RED_FULL 0
 #define BETA_RED_BOUNDED 1
 
+static uint32_t
+hash_beta_cache_tuple (const BtorBetaCacheTuple *t)
+{
+  assert (t);
+  return 333444569u * (uint32_t) t->lambda + 76891121u * (uint32_t) t->args;
+}
+
+static int32_t
+compare_beta_cache_tuple (const BtorBetaCacheTuple *t0,
+                          const BtorBetaCacheTuple *t1)
+{
+  assert (t0);
+  assert (t1);
+  return t0->lambda != t1->lambda || t0->args != t1->args;
+}
+
+/* Cache entries become stale if one of their nodes got released or
+ * simplified, e.g., if the body of the lambda was substituted. */
+static bool
+is_valid_node (Btor *btor, int32_t id)
+{
+  BtorNode *n = btor_node_get_by_id (btor, id);
+  return n && !btor_node_is_simplified (n);
+}
+
+static bool
+is_valid_beta_cache_tuple (Btor *btor, BtorBetaCacheTuple *t)
+{
+  return is_valid_node (btor, t->lambda) && is_valid_node (btor, t->args)
+         && is_valid_node (btor, t->result);
+}
+
+void
+btor_beta_cache_init (Btor *btor)
+{
+  assert (btor);
+  assert (!btor->beta_cache);
+  btor->beta_cache =
+      btor_hashptr_table_new (btor->mm,
+                              (BtorHashPtr) hash_beta_cache_tuple,
+                              (BtorCmpPtr) compare_beta_cache_tuple);
+}
+
+void
+btor_beta_cache_delete (Btor *btor)
+{
+  assert (btor);
+  assert (btor->beta_cache);
+
+  BtorPtrHashTableIterator it;
+  BtorBetaCacheTuple *t;
+
+  btor_iter_hashptr_init (&it, btor->beta_cache);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    t = btor_iter_hashptr_next (&it);
+    BTOR_DELETE (btor->mm, t);
+  }
+  btor_hashptr_table_delete (btor->beta_cache);
+  btor->beta_cache = 0;
+}
+
+void
+btor_beta_cache_reset (Btor *btor)
+{
+  assert (btor);
+  btor->stats.beta_cache_removed += btor->beta_cache->count;
+  btor_beta_cache_delete (btor);
+  btor_beta_cache_init (btor);
+}
+
+/* Remove all stale entries. */
+static void
+gc_beta_cache (Btor *btor)
+{
+  BtorPtrHashTableIterator it;
+  BtorBetaCacheTuple *t;
+  BtorPtrHashTable *old;
+
+  old              = btor->beta_cache;
+  btor->beta_cache = btor_hashptr_table_new (btor->mm, old->hash, old->cmp);
+
+  btor_iter_hashptr_init (&it, old);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    t = btor_iter_hashptr_next (&it);
+    if (is_valid_beta_cache_tuple (btor, t))
+      btor_hashptr_table_add (btor->beta_cache, t);
+    else
+    {
+      BTOR_DELETE (btor->mm, t);
+      btor->stats.beta_cache_removed++;
+    }
+  }
+  btor_hashptr_table_delete (old);
+}
+
 static void
 cache_beta_result (Btor *btor,
-                   BtorPtrHashTable *cache,
                    BtorNode *lambda,
                    BtorNode *exp,
                    BtorNode *result)
 {
   assert (btor);
-  assert (cache);
   assert (lambda);
   assert (exp);
   assert (result);
@@ -39,19 +134,33 @@ cache_beta_result (Btor *btor,
   assert (btor_node_is_regular (lambda));
   assert (btor_node_is_lambda (lambda));
 
-  BtorNodePair *pair;
+  uint32_t limit;
+  BtorBetaCacheTuple key, *t;
   BtorPtrHashBucket *bucket;
 
-  pair   = btor_node_pair_new (btor, lambda, exp);
-  bucket = btor_hashptr_table_get (cache, pair);
+  key.lambda = btor_node_get_id (lambda);
+  key.args   = btor_node_get_id (exp);
+  bucket     = btor_hashptr_table_get (btor->beta_cache, &key);
   if (bucket)
   {
-    btor_node_pair_delete (btor, pair);
-    assert ((BtorNode *) bucket->data.as_ptr == result);
+    /* replace previous, possibly stale result */
+    t         = bucket->key;
+    t->result = btor_node_get_id (result);
   }
   else
-    btor_hashptr_table_add (cache, pair)->data.as_ptr =
-        btor_node_copy (btor, result);
+  {
+    limit = btor_opt_get (btor, BTOR_OPT_BETA_REDUCE_CACHE);
+    if (limit && btor->beta_cache->count >= limit)
+    {
+      gc_beta_cache (btor);
+      if (btor->beta_cache->count >= limit) btor_beta_cache_reset (btor);
+    }
+    BTOR_NEW (btor->mm, t);
+    t->lambda = key.lambda;
+    t->args   = key.args;
+    t->result = btor_node_get_id (result);
+    btor_hashptr_table_add (btor->beta_cache, t);
+  }
   BTORLOG (3,
            "%s: (%s, %s) -> %s",
            __FUNCTION__,
@@ -61,10 +170,7 @@ cache_beta_result (Btor *btor,
 }
 
 static BtorNode *
-cached_beta_result (Btor *btor,
-                    BtorPtrHashTable *cache,
-                    BtorNode *lambda,
-                    BtorNode *exp)
+cached_beta_result (Btor *btor, BtorNode *lambda, BtorNode *exp)
 {
   assert (btor);
   assert (lambda);
@@ -72,25 +178,27 @@ cached_beta_result (Btor *btor,
   assert (btor_node_is_regular (lambda));
   assert (btor_node_is_lambda (lambda));
 
-  BtorNodePair *pair;
+  BtorBetaCacheTuple key, *t;
   BtorPtrHashBucket *bucket;
+  BtorNode *result;
 
-  pair   = btor_node_pair_new (btor, lambda, exp);
-  bucket = btor_hashptr_table_get (cache, pair);
-  btor_node_pair_delete (btor, pair);
+  key.lambda = btor_node_get_id (lambda);
+  key.args   = btor_node_get_id (exp);
+  bucket     = btor_hashptr_table_get (btor->beta_cache, &key);
 
-  if (bucket)
-  {
-    BTORLOG (3,
-             "%s: (%s, %s) -> %s",
-             __FUNCTION__,
-             btor_util_node2string (lambda),
-             btor_util_node2string (exp),
-             btor_util_node2string (bucket->data.as_ptr));
-    return (BtorNode *) bucket->data.as_ptr;
-  }
+  if (!bucket) return 0;
 
-  return 0;
+  t = bucket->key;
+  if (!is_valid_node (btor, t->result)) return 0;
+  result = btor_node_get_by_id (btor, t->result);
+  btor->stats.beta_cache_hits++;
+  BTORLOG (3,
+           "%s: (%s, %s) -> %s",
+           __FUNCTION__,
+           btor_util_node2string (lambda),
+           btor_util_node2string (exp),
+           btor_util_node2string (result));
+  return result;
 }
 
 void
@@ -172,7 +280,7 @@ beta_reduce (Btor *btor,
              int32_t mode,
              int32_t bound,
              BtorPtrHashTable *merge_lambdas,
-             BtorPtrHashTable *cache)
+             bool cache)
 {
   assert (btor);
   assert (exp);
@@ -292,7 +400,7 @@ beta_reduce (Btor *btor,
 
         if (cache)
         {
-          cached = cached_beta_result (btor, cache, real_cur, args);
+          cached = cached_beta_result (btor, real_cur, args);
           if (cached)
           {
             assert (!real_cur->parameterized);
@@ -447,8 +555,9 @@ beta_reduce (Btor *btor,
           }
 
           if (cache && mode == BETA_RED_FULL
-              && btor_node_is_lambda (real_cur->e[0]))
-            cache_beta_result (btor, cache, real_cur->e[0], e[0], result);
+              && btor_node_is_lambda (real_cur->e[0])
+              && !btor_node_real_addr (real_cur->e[0])->parameterized)
+            cache_beta_result (btor, real_cur->e[0], e[0], result);
 
           btor_node_release (btor, e[0]);
           btor_node_release (btor, e[1]);
@@ -906,10 +1015,10 @@ beta_reduce_partial_aux (Btor *btor,
 }
 
 BtorNode *
-btor_beta_reduce_full (Btor *btor, BtorNode *exp, BtorPtrHashTable *cache)
+btor_beta_reduce_full (Btor *btor, BtorNode *exp)
 {
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
-  return beta_reduce (btor, exp, BETA_RED_FULL, 0, 0, cache);
+  return beta_reduce (btor, exp, BETA_RED_FULL, 0, 0, true);
 }
 
 BtorNode *
@@ -918,14 +1027,15 @@ btor_beta_reduce_merge (Btor *btor,
                         BtorPtrHashTable *merge_lambdas)
 {
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
-  return beta_reduce (btor, exp, BETA_RED_LAMBDA_MERGE, 0, merge_lambdas, 0);
+  return beta_reduce (
+      btor, exp, BETA_RED_LAMBDA_MERGE, 0, merge_lambdas, false);
 }
 
 BtorNode *
 btor_beta_reduce_bounded (Btor *btor, BtorNode *exp, int32_t bound)
 {
   BTORLOG (2, "%s: %s", __FUNCTION__, btor_util_node2string (exp));
-  return beta_reduce (btor, exp, BETA_RED_BOUNDED, bound, 0, 0);
+  return beta_reduce (btor, exp, BETA_RED_BOUNDED, bound, 0, false);
 }
 
 BtorNode *
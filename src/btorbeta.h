@@ -14,9 +14,21 @@
 #include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
 
-BtorNode* btor_beta_reduce_full (Btor* btor,
-                                 BtorNode* exp,
-                                 BtorPtrHashTable* cache);
+/* Entry of the persistent beta reduction cache: full reduction of applying
+ * lambda 'lambda' to arguments 'args' yields 'result'.  Nodes are stored by
+ * id (node ids are never reused), no references are held. */
+struct BtorBetaCacheTuple
+{
+  int32_t lambda;
+  int32_t args;
+  int32_t result;
+};
+
+typedef struct BtorBetaCacheTuple BtorBetaCacheTuple;
+
+/* Fully beta reduce 'exp'.  Results of reduced applications are memoised in
+ * 'btor->beta_cache' across calls. */
+BtorNode* btor_beta_reduce_full (Btor* btor, BtorNode* exp);
 
 BtorNode* btor_beta_reduce_merge (Btor* btor,
                                   BtorNode* exp,
@@ -38,6 +50,15 @@ BtorNode* btor_beta_reduce_partial_collect_new (Btor* btor,
 
 BtorNode* btor_beta_reduce_bounded (Btor* btor, BtorNode* exp, int32_t bound);
 
+/* Create the persistent beta reduction cache 'btor->beta_cache'. */
+void btor_beta_cache_init (Btor* btor);
+
+/* Delete the persistent beta reduction cache. */
+void btor_beta_cache_delete (Btor* btor);
+
+/* Remove all entries of the persistent beta reduction cache. */
+void btor_beta_cache_reset (Btor* btor);
+
 void btor_beta_assign_param (Btor* btor, BtorNode* lambda, BtorNode* arg);
 
 void btor_beta_assign_args (Btor* btor, BtorNode* fun, BtorNode* args);
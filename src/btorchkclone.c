@@ -199,6 +199,8 @@ chkclone_state (Btor *btor, Btor *clone)
   assert (clone);
 
   BTOR_CHKCLONE_STATE (rec_rw_calls);
+  BTOR_CHKCLONE_STATE (rec_rw_bound);
+  BTOR_CHKCLONE_STATE (rw_driver);
   BTOR_CHKCLONE_STATE (valid_assignments);
   BTOR_CHKCLONE_STATE (vis_idx);
   BTOR_CHKCLONE_STATE (inconsistent);
@@ -229,24 +231,29 @@ chkclone_stats (Btor *btor, Btor *clone)
   assert (clone);
 
 #ifndef NDEBUG
-  BtorPtrHashTableIterator it, cit;
-  BtorHashTableData *data, *cdata;
-  char *key, *ckey;
+  uint32_t i;
 #endif
 
   BTOR_CHKCLONE_STATS (max_rec_rw_calls);
+  BTOR_CHKCLONE_STATS (rw_fixpoint_passes);
   BTOR_CHKCLONE_STATS (var_substitutions);
   BTOR_CHKCLONE_STATS (uf_substitutions);
   BTOR_CHKCLONE_STATS (ec_substitutions);
   BTOR_CHKCLONE_STATS (linear_equations);
   BTOR_CHKCLONE_STATS (gaussian_eliminations);
   BTOR_CHKCLONE_STATS (eliminated_slices);
+  BTOR_CHKCLONE_STATS (absint_substitutions);
   BTOR_CHKCLONE_STATS (skeleton_constraints);
+  BTOR_CHKCLONE_STATS (decomp_components);
+  BTOR_CHKCLONE_STATS (bw_reduce_rounds);
+  BTOR_CHKCLONE_STATS (ls_portfolio_workers);
+  BTOR_CHKCLONE_STATS (sat_rebuilds);
   BTOR_CHKCLONE_STATS (adds_normalized);
   BTOR_CHKCLONE_STATS (ands_normalized);
   BTOR_CHKCLONE_STATS (muls_normalized);
   BTOR_CHKCLONE_STATS (muls_normalized);
   BTOR_CHKCLONE_STATS (ackermann_constraints);
+  BTOR_CHKCLONE_STATS (ackermann_skipped);
   BTOR_CHKCLONE_STATS (bv_uc_props);
   BTOR_CHKCLONE_STATS (fun_uc_props);
   BTOR_CHKCLONE_STATS (lambdas_merged);
@@ -265,28 +272,14 @@ chkclone_stats (Btor *btor, Btor *clone)
   BTOR_CHKCLONE_CONSTRAINTSTATS (oldconstraints, synthesized);
 
 #ifndef NDEBUG
-  assert (btor->stats.rw_rules_applied && clone->stats.rw_rules_applied);
-  assert (btor->stats.rw_rules_applied->size
-          == clone->stats.rw_rules_applied->size);
-  assert (btor->stats.rw_rules_applied->count
-          == clone->stats.rw_rules_applied->count);
-  assert (btor->stats.rw_rules_applied->hash
-          == clone->stats.rw_rules_applied->hash);
-  assert (btor->stats.rw_rules_applied->cmp
-          == clone->stats.rw_rules_applied->cmp);
-  btor_iter_hashptr_init (&it, btor->stats.rw_rules_applied);
-  btor_iter_hashptr_init (&cit, clone->stats.rw_rules_applied);
-  while (btor_iter_hashptr_has_next (&it))
+  for (i = 0; i < BTOR_RW_NUM_RULES; i++)
   {
-    assert (btor_iter_hashptr_has_next (&cit));
-    data  = &it.bucket->data;
-    cdata = &cit.bucket->data;
-    key   = (char *) btor_iter_hashptr_next (&it);
-    ckey  = (char *) btor_iter_hashptr_next (&cit);
-    assert (!strcmp (key, ckey));
-    assert (data->as_int == cdata->as_int);
+    assert (btor->stats.rw_rules[i].attempts
+            == clone->stats.rw_rules[i].attempts);
+    assert (btor->stats.rw_rules[i].applied
+            == clone->stats.rw_rules[i].applied);
+    assert (btor->stats.rw_rules[i].nodes == clone->stats.rw_rules[i].nodes);
   }
-  assert (!btor_iter_hashptr_has_next (&cit));
 #endif
 
   BTOR_CHKCLONE_STATS (expressions);
@@ -1038,6 +1031,7 @@ chkclone_slv (Btor *btor, Btor *clone)
     BtorPtrHashTableIterator cit;
 
     chkclone_node_ptr_hash_table (slv->lemmas, cslv->lemmas, 0);
+    chkclone_int_hash_table (slv->init_apps_cache, cslv->init_apps_cache);
 
     if (slv->score)
     {
@@ -1092,9 +1086,11 @@ chkclone_slv (Btor *btor, Btor *clone)
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_applies);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_failed_eqs);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_assumed_eqs);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, dp_clones);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, eval_exp_calls);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations);
     BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations_down);
+    BTOR_CHKCLONE_SLV_STATS (slv, cslv, propagations_skipped);
   }
   else if (btor->slv->kind == BTOR_SLS_SOLVER_KIND)
   {
@@ -100,6 +100,19 @@ btor_clone_key_as_rw_cache_tuple (BtorMemMgr *mm,
   return res;
 }
 
+static void *
+clone_key_as_beta_cache_tuple (BtorMemMgr *mm, const void *map, const void *t)
+{
+  assert (mm);
+  assert (t);
+  (void) map;
+
+  BtorBetaCacheTuple *res;
+  BTOR_NEW (mm, res);
+  memcpy (res, t, sizeof (BtorBetaCacheTuple));
+  return res;
+}
+
 void
 btor_clone_data_as_node_ptr (BtorMemMgr *mm,
                              const void *map,
@@ -938,16 +951,7 @@ clone_aux_btor (Btor *btor,
     clone->btor_sat_btor_called = 0;
     clone->last_sat_result      = 0;
     btor_reset_time (clone);
-#ifndef NDEBUG
-    /* we need to explicitely reset the pointer to the table, since
-     * it is the memcpy-ied pointer of btor->stats.rw_rules_applied */
-    clone->stats.rw_rules_applied = 0;
-#endif
     btor_reset_stats (clone);
-#ifndef NDEBUG
-    allocated += MEM_PTR_HASH_TABLE (clone->stats.rw_rules_applied);
-    assert (allocated == clone->mm->allocated);
-#endif
   }
 
   clone->msg = btor_msg_new (clone);
@@ -1228,6 +1232,24 @@ clone_aux_btor (Btor *btor,
            BTOR_SIZE_STACK (btor->assertions_trail) * sizeof (uint32_t))
           == clone->mm->allocated);
 
+  BTOR_INIT_STACK (clone->mm, clone->assertions_actlits);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_actlits); i++)
+  {
+    exp = BTOR_PEEK_STACK (btor->assertions_actlits, i);
+    BTOR_PUSH_STACK (clone->assertions_actlits,
+                     exp ? btor_nodemap_mapped (emap, exp) : 0);
+  }
+  BTOR_ADJUST_STACK (btor->assertions_actlits, clone->assertions_actlits);
+  assert ((allocated +=
+           BTOR_SIZE_STACK (btor->assertions_actlits) * sizeof (BtorNode *))
+          == clone->mm->allocated);
+
+  btor_clone_node_ptr_stack (
+      mm, &btor->retired_actlits, &clone->retired_actlits, emap, false);
+  assert ((allocated +=
+           BTOR_SIZE_STACK (btor->retired_actlits) * sizeof (BtorNode *))
+          == clone->mm->allocated);
+
   if (btor->bv_model)
   {
     clone->bv_model = btor_model_clone_bv (clone, btor->bv_model, false);
@@ -1246,20 +1268,6 @@ clone_aux_btor (Btor *btor,
   }
   assert ((allocated += MEM_INT_HASH_MAP (btor->bv_model))
           == clone->mm->allocated);
-#ifndef NDEBUG
-  if (!exp_layer_only && btor->stats.rw_rules_applied)
-  {
-    clone->stats.rw_rules_applied =
-        btor_hashptr_table_clone (mm,
-                                  btor->stats.rw_rules_applied,
-                                  btor_clone_key_as_static_str,
-                                  btor_clone_data_as_int,
-                                  0,
-                                  0);
-    assert ((allocated += MEM_PTR_HASH_TABLE (btor->stats.rw_rules_applied))
-            == clone->mm->allocated);
-  }
-#endif
   if (btor->fun_model)
   {
     clone->fun_model = btor_model_clone_fun (clone, btor->fun_model, false);
@@ -1376,6 +1384,13 @@ clone_aux_btor (Btor *btor,
   allocated += btor->rw_cache->cache->count * sizeof (BtorRwCacheTuple);
   allocated += MEM_PTR_HASH_TABLE (btor->rw_cache->cache);
 #endif
+  clone->beta_cache = btor_hashptr_table_clone (
+      mm, btor->beta_cache, clone_key_as_beta_cache_tuple, 0, 0, 0);
+#ifndef NDEBUG
+  CHKCLONE_MEM_PTR_HASH_TABLE (btor->beta_cache, clone->beta_cache);
+  allocated += btor->beta_cache->count * sizeof (BtorBetaCacheTuple);
+  allocated += MEM_PTR_HASH_TABLE (btor->beta_cache);
+#endif
 
   /* move synthesized constraints to unsynthesized if we only clone the exp
    * layer */
@@ -1421,6 +1436,15 @@ clone_aux_btor (Btor *btor,
 
       allocated += MEM_PTR_HASH_TABLE (slv->lemmas);
       allocated += BTOR_SIZE_STACK (slv->cur_lemmas) * sizeof (BtorNode *);
+      allocated += BTOR_SIZE_STACK (slv->init_apps) * sizeof (BtorNode *);
+      allocated += MEM_INT_HASH_TABLE (slv->init_apps_cache);
+      if (cslv->dp_clone)
+      {
+        allocated += sizeof (BtorNodeMap);
+        allocated += MEM_PTR_HASH_TABLE (cslv->dp_exp_map->table);
+        allocated += MEM_PTR_HASH_TABLE (cslv->dp_constraints);
+        allocated += MEM_PTR_HASH_TABLE (cslv->dp_assumed);
+      }
 
       if (slv->score)
       {
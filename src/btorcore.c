@@ -14,6 +14,7 @@
 #include <limits.h>
 
 #include "btorabort.h"
+#include "btorbeta.h"
 #ifndef NDEBUG
 #include "btorchkfailed.h"
 #include "btorchkmodel.h"
@@ -23,6 +24,7 @@
 #include "btordbg.h"
 #include "btorexp.h"
 #include "btorlog.h"
+#include "btorlsportfolio.h"
 #include "btormodel.h"
 #include "btoropt.h"
 #include "btorrewrite.h"
@@ -32,6 +34,8 @@
 #include "btorslvquant.h"
 #include "btorslvsls.h"
 #include "btorsubst.h"
+#include "preprocess/btorbwreduce.h"
+#include "preprocess/btordecomp.h"
 #include "preprocess/btorpreprocess.h"
 #include "preprocess/btorvarsubst.h"
 #include "utils/btorhashint.h"
@@ -287,16 +291,7 @@ void
 btor_reset_stats (Btor *btor)
 {
   assert (btor);
-#ifndef NDEBUG
-  if (btor->stats.rw_rules_applied)
-    btor_hashptr_table_delete (btor->stats.rw_rules_applied);
-#endif
   BTOR_CLR (&btor->stats);
-#ifndef NDEBUG
-  assert (!btor->stats.rw_rules_applied);
-  btor->stats.rw_rules_applied = btor_hashptr_table_new (
-      btor->mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
-#endif
 }
 
 static uint32_t
@@ -421,6 +416,10 @@ btor_print_stats (Btor *btor)
   {
     BTOR_MSG (btor->msg, 1, "");
     BTOR_MSG (btor->msg, 2, "%5d max rec. RW", btor->stats.max_rec_rw_calls);
+    BTOR_MSG (btor->msg,
+              2,
+              "%5d rec. RW fixpoint passes",
+              btor->stats.rw_fixpoint_passes);
     BTOR_MSG (btor->msg,
               2,
               "%5lld number of expressions ever created",
@@ -487,10 +486,35 @@ btor_print_stats (Btor *btor)
             1,
             "%5d eliminated sliced variables",
             btor->stats.eliminated_slices);
+  if (btor_opt_get (btor, BTOR_OPT_ABSINT))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d abstract interpretation substitutions",
+              btor->stats.absint_substitutions);
   BTOR_MSG (btor->msg,
             1,
             "%5d extracted skeleton constraints",
             btor->stats.skeleton_constraints);
+  if (btor_opt_get (btor, BTOR_OPT_DECOMPOSE))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d independently solved components",
+              btor->stats.decomp_components);
+  if (btor_opt_get (btor, BTOR_OPT_BW_REDUCE))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d bit-width reduction rounds",
+              btor->stats.bw_reduce_rounds);
+  if (btor_opt_get (btor, BTOR_OPT_LS_PORTFOLIO))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d local search portfolio workers",
+              btor->stats.ls_portfolio_workers);
+  if (btor_opt_get (btor, BTOR_OPT_SAT_GC))
+    BTOR_MSG (btor->msg,
+              1,
+              "%5d SAT instance rebuilds",
+              btor->stats.sat_rebuilds);
   BTOR_MSG (
       btor->msg, 1, "%5d and normalizations", btor->stats.ands_normalized);
   BTOR_MSG (
@@ -508,6 +532,14 @@ btor_print_stats (Btor *btor)
             btor->stats.prop_apply_update);
   BTOR_MSG (
       btor->msg, 1, "%5lld beta reductions", btor->stats.beta_reduce_calls);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5lld beta reduction cache hits",
+            btor->stats.beta_cache_hits);
+  BTOR_MSG (btor->msg,
+            1,
+            "%5lld beta reduction cache entries removed",
+            btor->stats.beta_cache_removed);
   BTOR_MSG (btor->msg, 1, "%5lld clone calls", btor->stats.clone_calls);
 
   BTOR_MSG (btor->msg, 1, "");
@@ -524,24 +556,11 @@ btor_print_stats (Btor *btor)
              + btor->rw_cache->cache->size * sizeof (BtorPtrHashBucket *))
                 / (double) (1 << 20));
 
-#ifndef NDEBUG
-  BtorPtrHashTableIterator it;
-  char *rule;
-  int32_t num = 0;
-  BTOR_MSG (btor->msg, 1, "applied rewriting rules:");
-  if (btor->stats.rw_rules_applied->count == 0)
-    BTOR_MSG (btor->msg, 1, "  none");
-  else
+  if (btor_opt_get (btor, BTOR_OPT_REWRITE_PROFILE))
   {
-    btor_iter_hashptr_init (&it, btor->stats.rw_rules_applied);
-    while (btor_iter_hashptr_has_next (&it))
-    {
-      num  = it.bucket->data.as_int;
-      rule = btor_iter_hashptr_next (&it);
-      BTOR_MSG (btor->msg, 1, "  %5d %s", num, rule);
-    }
+    BTOR_MSG (btor->msg, 1, "");
+    btor_rewrite_print_profile (btor);
   }
-#endif
 
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg, 1, "bit blasting statistics:");
@@ -662,9 +681,33 @@ btor_print_stats (Btor *btor)
               btor->time.ack,
               percent (btor->time.ack, btor->time.simplify));
 
+  if (btor_opt_get (btor, BTOR_OPT_DECOMPOSE))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %.2f seconds decomposed solving",
+              btor->time.decomp);
+  if (btor_opt_get (btor, BTOR_OPT_BW_REDUCE))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %.2f seconds bit-width reduced solving",
+              btor->time.bw_reduce);
+  if (btor_opt_get (btor, BTOR_OPT_LS_PORTFOLIO))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %.2f seconds local search portfolio",
+              btor->time.ls_portfolio);
+
+  if (btor_opt_get (btor, BTOR_OPT_SAT_GC))
+    BTOR_MSG (btor->msg,
+              1,
+              "  %.2f seconds SAT instance rebuilds",
+              btor->time.sat_gc);
+
   if (btor->slv) btor->slv->api.print_time_stats (btor->slv);
 #endif
 
+  btor_print_pp_pass_stats (btor);
+
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (
       btor->msg, 1, "%.1f MB", btor->mm->maxallocated / (double) (1 << 20));
@@ -768,17 +811,15 @@ btor_new (void)
 
   BTOR_INIT_STACK (mm, btor->assertions);
   BTOR_INIT_STACK (mm, btor->assertions_trail);
+  BTOR_INIT_STACK (mm, btor->assertions_actlits);
+  BTOR_INIT_STACK (mm, btor->retired_actlits);
   btor->assertions_cache = btor_hashint_table_new (mm);
 
-#ifndef NDEBUG
-  btor->stats.rw_rules_applied = btor_hashptr_table_new (
-      mm, (BtorHashPtr) btor_hash_str, (BtorCmpPtr) strcmp);
-#endif
-
   btor->true_exp = btor_exp_true (btor);
 
   BTOR_CNEW (mm, btor->rw_cache);
   btor_rw_cache_init (btor->rw_cache, btor);
+  btor_beta_cache_init (btor);
 
   return btor;
 }
@@ -944,6 +985,13 @@ btor_delete (Btor *btor)
     btor_node_release (btor, BTOR_PEEK_STACK (btor->assertions, i));
   BTOR_RELEASE_STACK (btor->assertions);
   BTOR_RELEASE_STACK (btor->assertions_trail);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_actlits); i++)
+    if (BTOR_PEEK_STACK (btor->assertions_actlits, i))
+      btor_node_release (btor, BTOR_PEEK_STACK (btor->assertions_actlits, i));
+  BTOR_RELEASE_STACK (btor->assertions_actlits);
+  for (i = 0; i < BTOR_COUNT_STACK (btor->retired_actlits); i++)
+    btor_node_release (btor, BTOR_PEEK_STACK (btor->retired_actlits, i));
+  BTOR_RELEASE_STACK (btor->retired_actlits);
   btor_hashint_table_delete (btor->assertions_cache);
 
   btor_model_delete (btor);
@@ -1046,15 +1094,13 @@ btor_delete (Btor *btor)
   btor_hashptr_table_delete (btor->forall_vars);
   btor_hashptr_table_delete (btor->feqs);
   btor_hashptr_table_delete (btor->parameterized);
-#ifndef NDEBUG
-  btor_hashptr_table_delete (btor->stats.rw_rules_applied);
-#endif
 
   if (btor->avmgr) btor_aigvec_mgr_delete (btor->avmgr);
   btor_opt_delete_opts (btor);
 
   btor_rw_cache_delete (btor->rw_cache);
   BTOR_DELETE (mm, btor->rw_cache);
+  btor_beta_cache_delete (btor);
 
   assert (btor->rec_rw_calls == 0);
   btor_msg_delete (btor->msg);
@@ -1154,6 +1200,70 @@ btor_process_unsynthesized_constraints (Btor *btor)
   }
 }
 
+/* Rebuild the SAT instance from the AIGs of synthesized expressions and
+ * the synthesized constraints if too many of its CNF variables belong to
+ * deleted AIGs.  Clauses of deleted AIGs are otherwise only melted and stay
+ * in the SAT solver forever. */
+void
+btor_sat_gc (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, ratio;
+  int32_t maxvar;
+  uint_least64_t dead;
+  double start;
+  BtorNode *cur;
+  BtorAIG *aig;
+  BtorAIGMgr *amgr;
+  BtorSATMgr *smgr;
+  BtorPtrHashTableIterator it;
+
+  ratio = btor_opt_get (btor, BTOR_OPT_SAT_GC);
+  if (!ratio) return;
+  if (btor->inconsistent || btor->found_constraint_false) return;
+  if (btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS)) return;
+
+  amgr = btor_get_aig_mgr (btor);
+  smgr = btor_get_sat_mgr (btor);
+  if (!btor_sat_is_initialized (smgr) || !smgr->satcalls) return;
+  if (smgr->have_restore) return;
+
+  dead   = amgr->cur_num_dead_cnf_vars;
+  maxvar = smgr->maxvar;
+  if (dead * 100 < (uint_least64_t) ratio * maxvar) return;
+
+  start = btor_util_time_stamp ();
+  btor_aig_mgr_reset_cnf (amgr);
+  btor_sat_reinit (smgr);
+
+  for (i = 1; i < BTOR_COUNT_STACK (btor->nodes_id_table); i++)
+  {
+    cur = BTOR_PEEK_STACK (btor->nodes_id_table, i);
+    if (!cur || !btor_node_is_synth (cur)) continue;
+    btor_aigvec_to_sat_tseitin (btor->avmgr, cur->av);
+  }
+
+  btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    aig = exp_to_aig (btor, cur);
+    btor_aig_add_toplevel_to_sat (amgr, aig);
+    btor_aig_release (amgr, aig);
+  }
+
+  btor->stats.sat_rebuilds++;
+  btor->time.sat_gc += btor_util_time_stamp () - start;
+  BTOR_MSG (btor->msg,
+            1,
+            "rebuilt SAT instance with %d instead of %d CNF variables "
+            "(%llu dead)",
+            smgr->maxvar,
+            maxvar,
+            (unsigned long long) dead);
+}
+
 void
 btor_insert_unsynthesized_constraint (Btor *btor, BtorNode *exp)
 {
@@ -2906,6 +3016,27 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
       btor_assume_exp (btor, BTOR_PEEK_STACK (btor->assertions, i));
     }
   }
+  /* Permanently disable the assertions of popped context levels.  This is
+   * delayed until here to keep the model of the previous call valid after
+   * boolector_pop. */
+  while (!BTOR_EMPTY_STACK (btor->retired_actlits))
+  {
+    BtorNode *actlit = BTOR_POP_STACK (btor->retired_actlits);
+    btor_assert_exp (btor, btor_node_invert (actlit));
+    btor_node_release (btor, actlit);
+  }
+  /* Context levels with activation literals only require to assume the
+   * literals of all open levels. */
+  if (BTOR_COUNT_STACK (btor->assertions_actlits) > 0)
+  {
+    uint32_t i;
+    BtorNode *actlit;
+    for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_actlits); i++)
+    {
+      actlit = BTOR_PEEK_STACK (btor->assertions_actlits, i);
+      if (actlit) btor_assume_exp (btor, actlit);
+    }
+  }
 
 #ifndef NDEBUG
   // NOTE: disable checking if quantifiers present for now (not supported yet)
@@ -2915,7 +3046,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   if (check && btor_opt_get (btor, BTOR_OPT_CHK_UNCONSTRAINED)
       && btor_opt_get (btor, BTOR_OPT_UCOPT)
       && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-      && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+      && (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+          || btor_opt_get (btor, BTOR_OPT_INCREMENTAL_SIMP))
       && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN)
       && !btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS))
   {
@@ -2955,6 +3087,18 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
   }
 
+  /* the prop engine supports UFs and arrays if all lambdas are eliminated,
+   * i.e., if only applications on UFs are left */
+  if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP
+      && btor->ufs->count > 0 && btor->feqs->count == 0
+      && btor->quantifiers->count == 0)
+  {
+    BTOR_MSG (btor->msg,
+              1,
+              "found UFs with engine prop, enable beta-reduction=all");
+    btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
+  }
+
   // FIXME (ma): not sound with slice elimination. see red-vsl.proof3106.smt2
   /* disabling slice elimination is better on QF_ABV and BV */
   if (btor->ufs->count > 0 || btor->quantifiers->count > 0)
@@ -2990,8 +3134,13 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
                    "Quantifiers not supported for -E sls");
         btor->slv = btor_new_sls_solver (btor);
       }
-      else if (engine == BTOR_ENGINE_PROP && btor->ufs->count == 0
-               && btor->feqs->count == 0)
+      /* prop also works on QF_ABV and QF_UFBV (without extensionality) if
+       * all lambdas and updates are eliminated */
+      else if (engine == BTOR_ENGINE_PROP && btor->feqs->count == 0
+               && (btor->ufs->count == 0 || btor->quantifiers->count == 0)
+               && ((btor->ufs->count == 0 && btor->lambdas->count == 0)
+                   || btor_opt_get (btor, BTOR_OPT_BETA_REDUCE)
+                          == BTOR_BETA_REDUCE_ALL))
       {
         assert (btor->lambdas->count == 0
                 || btor_opt_get (btor, BTOR_OPT_BETA_REDUCE));
@@ -3033,7 +3182,9 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
     }
 
     assert (btor->slv);
-    res = btor->slv->api.sat (btor->slv);
+    if (!btor_decompose_sat (btor, &res) && !btor_bw_reduce_sat (btor, &res)
+        && !btor_ls_portfolio_sat (btor, &res))
+      res = btor->slv->api.sat (btor->slv);
   }
   btor->last_sat_result = res;
   btor->btor_sat_btor_called++;
@@ -3060,7 +3211,8 @@ btor_check_sat (Btor *btor, int32_t lod_limit, int32_t sat_limit)
   {
     assert (btor_opt_get (btor, BTOR_OPT_UCOPT));
     assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
-    assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
+    assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+            || btor_opt_get (btor, BTOR_OPT_INCREMENTAL_SIMP));
     assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
     BtorSolverResult ucres = btor_check_sat (uclone, -1, -1);
     assert (res == ucres);
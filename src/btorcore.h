@@ -16,11 +16,13 @@
 #include "btormsg.h"
 #include "btornode.h"
 #include "btoropt.h"
+#include "btorrewrite.h"
 #include "btorrwcache.h"
 #include "btorsat.h"
 #include "btorslv.h"
 #include "btorsort.h"
 #include "btortypes.h"
+#include "preprocess/btorpreprocess.h"
 #include "utils/btorhashint.h"
 #include "utils/btormem.h"
 #include "utils/btorrng.h"
@@ -125,8 +127,11 @@ struct Btor
   BtorNodePtrStack outputs; /* used to synthesize BTOR2 outputs */
 
   uint32_t rec_rw_calls; /* calls for recursive rewriting */
+  bool rec_rw_bound;     /* recursive rewriting bound reached */
+  bool rw_driver;        /* top level rewriting call active */
   uint32_t valid_assignments;
   BtorRwCache *rw_cache;
+  BtorPtrHashTable *beta_cache; /* persistent cache of reduced applies */
 
   int32_t vis_idx; /* file index for visualizing expressions */
 
@@ -157,6 +162,10 @@ struct Btor
   BtorIntHashTable *assertions_cache;
   /* saves the number of assertions on each push */
   BtorUIntStack assertions_trail;
+  /* activation literal of each context level (0 if not needed yet) */
+  BtorNodePtrStack assertions_actlits;
+  /* activation literals of popped levels, disabled on the next SAT call */
+  BtorNodePtrStack retired_actlits;
   /* Number of push/pop calls (used for unique symbol prefixes) */
   uint32_t num_push_pop;
 
@@ -183,17 +192,24 @@ struct Btor
   struct
   {
     uint32_t max_rec_rw_calls;  /* maximum number of recursive rewrite calls */
+    uint32_t rw_fixpoint_passes; /* passes to rewrite after reaching bound */
     uint32_t var_substitutions; /* number substituted vars */
     uint32_t uf_substitutions;  /* num substituted uninterpreted functions */
     uint32_t ec_substitutions;  /* embedded constraint substitutions */
     uint32_t linear_equations;  /* number of linear equations */
     uint32_t gaussian_eliminations; /* number of gaussian eliminations */
     uint32_t eliminated_slices;     /* number of eliminated slices */
+    uint32_t absint_substitutions;  /* abstract interpretation substitutions */
     uint32_t skeleton_constraints;  /* number of skeleton constraints */
+    uint32_t decomp_components;     /* number of independently solved parts */
+    uint32_t bw_reduce_rounds;      /* number of bit-width reduction rounds */
+    uint32_t ls_portfolio_workers;  /* number of started portfolio workers */
+    uint32_t sat_rebuilds;          /* number of SAT instance rebuilds */
     uint32_t adds_normalized;       /* number of add chains normalizations */
     uint32_t ands_normalized;       /* number of and chains normalizations */
     uint32_t muls_normalized;       /* number of mul chains normalizations */
     uint32_t ackermann_constraints;
+    uint_least64_t ackermann_skipped; /* pairs without ackermann constraint */
     uint_least64_t prop_apply_lambda; /* number of static props over lambdas */
     uint_least64_t prop_apply_update; /* number of static props over updates */
     uint32_t bv_uc_props;
@@ -206,10 +222,11 @@ struct Btor
     uint_least64_t clone_calls;
     size_t node_bytes_alloc;
     uint_least64_t beta_reduce_calls;
+    uint_least64_t beta_cache_hits;    /* reused beta reduction results */
+    uint_least64_t beta_cache_removed; /* removed beta cache entries */
     uint_least64_t betap_reduce_calls;
-#ifndef NDEBUG
-    BtorPtrHashTable *rw_rules_applied;
-#endif
+    BtorRwRuleStats rw_rules[BTOR_RW_NUM_RULES];
+    BtorPPPassStats pp_passes[BTOR_PP_NUM_PASSES];
     uint_least64_t rewrite_synth;
   } stats;
 
@@ -234,6 +251,10 @@ struct Btor
     double merge;
     double extract;
     double ack;
+    double decomp;
+    double bw_reduce;
+    double ls_portfolio;
+    double sat_gc;
     double rewrite;
     double occurrence;
   } time;
@@ -358,6 +379,7 @@ BtorNode *btor_substitute_nodes_node_map (Btor *btor,
 void btor_reset_incremental_usage (Btor *btor);
 void btor_add_again_assumptions (Btor *btor);
 void btor_process_unsynthesized_constraints (Btor *btor);
+void btor_sat_gc (Btor *btor);
 void btor_insert_unsynthesized_constraint (Btor *btor, BtorNode *constraint);
 void btor_set_simplified_exp (Btor *btor, BtorNode *exp, BtorNode *simplified);
 void btor_delete_varsubst_constraints (Btor *btor);
@@ -0,0 +1,310 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "btorlsportfolio.h"
+
+#include "btorclone.h"
+#include "btorcore.h"
+#include "btormodel.h"
+#include "btoropt.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+
+/*------------------------------------------------------------------------*/
+
+struct BtorLsPortfolio;
+
+struct BtorLsWorker
+{
+  struct BtorLsPortfolio *portfolio;
+  Btor *clone;
+  uint32_t engine;
+  BtorSolverResult result;
+};
+
+typedef struct BtorLsWorker BtorLsWorker;
+
+struct BtorLsPortfolio
+{
+  Btor *btor;
+  BtorLsWorker *workers;
+  uint32_t num_workers;
+  BtorLsWorker *winner; /* first worker with a conclusive result */
+  bool done;            /* terminates all workers */
+  pthread_mutex_t mutex;
+};
+
+typedef struct BtorLsPortfolio BtorLsPortfolio;
+
+static const uint32_t ls_engines[] = {
+    BTOR_ENGINE_PROP, BTOR_ENGINE_SLS, BTOR_ENGINE_AIGPROP};
+
+#define BTOR_LS_NUM_ENGINES (sizeof ls_engines / sizeof *ls_engines)
+
+/*------------------------------------------------------------------------*/
+
+static bool
+applies (Btor *btor)
+{
+  uint32_t engine;
+
+  if (btor_opt_get (btor, BTOR_OPT_LS_PORTFOLIO) < 2) return false;
+  engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
+  if (engine != BTOR_ENGINE_PROP && engine != BTOR_ENGINE_SLS
+      && engine != BTOR_ENGINE_AIGPROP)
+    return false;
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL)) return false;
+  if (btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS)) return false;
+  if (btor->ufs->count || btor->feqs->count || btor->quantifiers->count)
+    return false;
+  if (btor->assumptions->count) return false;
+  return true;
+}
+
+static bool
+need_model (Btor *btor)
+{
+  if (btor_opt_get (btor, BTOR_OPT_MODEL_GEN)) return true;
+#ifndef NDEBUG
+  /* btor_check_model generates a model even if model generation is off */
+  if (btor_opt_get (btor, BTOR_OPT_CHK_MODEL)) return true;
+#endif
+  return false;
+}
+
+static const char *
+engine_name (uint32_t engine)
+{
+  switch (engine)
+  {
+    case BTOR_ENGINE_SLS: return "sls";
+    case BTOR_ENGINE_PROP: return "prop";
+    case BTOR_ENGINE_AIGPROP: return "aigprop";
+    default: assert (engine == BTOR_ENGINE_FUN); return "fun";
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+terminate_ls_portfolio (void *state)
+{
+  BtorLsPortfolio *portfolio = state;
+  return portfolio->done || btor_terminate (portfolio->btor);
+}
+
+/* Worker 0 runs engine fun (for completeness), worker 1 the configured local
+ * search engine with the configured options.  All other workers cycle
+ * through the local search engines with different seeds, and in every
+ * further round with a different combination of restarts and bandit. */
+static void
+configure_worker (Btor *btor, Btor *clone, uint32_t idx)
+{
+  uint32_t i, engine, round;
+  BtorOption restarts, bandit;
+
+  if (idx == 0)
+  {
+    btor_opt_set (clone, BTOR_OPT_ENGINE, BTOR_ENGINE_FUN);
+    return;
+  }
+
+  engine = btor_opt_get (btor, BTOR_OPT_ENGINE);
+  for (i = 0; ls_engines[i] != engine; i++)
+    ;
+  engine = ls_engines[(i + idx - 1) % BTOR_LS_NUM_ENGINES];
+  btor_opt_set (clone, BTOR_OPT_ENGINE, engine);
+  if (idx == 1) return;
+
+  btor_opt_set (
+      clone, BTOR_OPT_SEED, btor_opt_get (btor, BTOR_OPT_SEED) + idx - 1);
+
+  switch (engine)
+  {
+    case BTOR_ENGINE_SLS:
+      restarts = BTOR_OPT_SLS_USE_RESTARTS;
+      bandit   = BTOR_OPT_SLS_USE_BANDIT;
+      break;
+    case BTOR_ENGINE_PROP:
+      restarts = BTOR_OPT_PROP_USE_RESTARTS;
+      bandit   = BTOR_OPT_PROP_USE_BANDIT;
+      break;
+    default:
+      assert (engine == BTOR_ENGINE_AIGPROP);
+      restarts = BTOR_OPT_AIGPROP_USE_RESTARTS;
+      bandit   = BTOR_OPT_AIGPROP_USE_BANDIT;
+  }
+  round = (idx - 1) / BTOR_LS_NUM_ENGINES;
+  if (round & 1) btor_opt_set (clone, bandit, !btor_opt_get (btor, bandit));
+  if (round & 2)
+    btor_opt_set (clone, restarts, !btor_opt_get (btor, restarts));
+}
+
+static void
+init_worker (BtorLsPortfolio *portfolio, uint32_t idx, bool model)
+{
+  char prefix[32];
+  Btor *btor, *clone;
+  BtorLsWorker *worker;
+
+  btor   = portfolio->btor;
+  worker = portfolio->workers + idx;
+
+  clone = btor_clone_btor (btor);
+  if (clone->slv)
+  {
+    clone->slv->api.delet (clone->slv);
+    clone->slv = 0;
+  }
+  configure_worker (btor, clone, idx);
+  btor_opt_set (clone, BTOR_OPT_LS_PORTFOLIO, 0);
+  btor_opt_set (clone, BTOR_OPT_DECOMPOSE, 0);
+  btor_opt_set (clone, BTOR_OPT_CHK_MODEL, 0);
+  btor_opt_set (clone, BTOR_OPT_CHK_UNCONSTRAINED, 0);
+  btor_opt_set (clone, BTOR_OPT_CHK_FAILED_ASSUMPTIONS, 0);
+  if (model) btor_opt_set (clone, BTOR_OPT_MODEL_GEN, 1);
+  sprintf (prefix, "portfolio%u", idx);
+  btor_set_msg_prefix (clone, prefix);
+  btor_set_term (clone, terminate_ls_portfolio, portfolio);
+
+  worker->portfolio = portfolio;
+  worker->clone     = clone;
+  worker->engine    = btor_opt_get (clone, BTOR_OPT_ENGINE);
+  worker->result    = BTOR_RESULT_UNKNOWN;
+}
+
+static void
+run_worker (BtorLsWorker *worker)
+{
+  BtorSolverResult res;
+  BtorLsPortfolio *portfolio;
+
+  portfolio = worker->portfolio;
+  res       = btor_check_sat (worker->clone, -1, -1);
+
+  pthread_mutex_lock (&portfolio->mutex);
+  worker->result = res;
+  if (res != BTOR_RESULT_UNKNOWN && !portfolio->done)
+  {
+    portfolio->winner = worker;
+    portfolio->done   = true;
+  }
+  pthread_mutex_unlock (&portfolio->mutex);
+}
+
+static void *
+thread_work (void *state)
+{
+  run_worker (state);
+  return NULL;
+}
+
+/* Node ids are preserved by cloning, nodes that were created by a worker
+ * do not occur in the original instance. */
+static void
+copy_model (Btor *btor, Btor *clone)
+{
+  int32_t id;
+  BtorNode *var;
+  BtorBitVector *bv;
+  BtorIntHashTableIterator it;
+
+  btor_model_init_bv (btor, &btor->bv_model);
+  btor_model_init_fun (btor, &btor->fun_model);
+  btor_iter_hashint_init (&it, clone->bv_model);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    bv  = clone->bv_model->data[it.cur_pos].as_ptr;
+    id  = btor_iter_hashint_next (&it);
+    var = id > 0 ? btor_node_get_by_id (btor, id) : 0;
+    if (!var || !btor_node_is_bv_var (var)) continue;
+    btor_model_add_to_bv (btor, btor->bv_model, var, bv);
+  }
+  btor_model_generate (btor,
+                       btor->bv_model,
+                       btor->fun_model,
+                       btor_opt_get (btor, BTOR_OPT_MODEL_GEN) == 2);
+}
+#endif
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_ls_portfolio_sat (Btor *btor, BtorSolverResult *result)
+{
+  assert (btor);
+  assert (result);
+
+#ifdef BTOR_HAVE_PTHREADS
+  uint32_t i, num_workers;
+  double start;
+  bool model;
+  BtorSolverResult res;
+  BtorLsPortfolio portfolio;
+  BtorLsWorker *winner;
+  pthread_t *threads;
+
+  if (!applies (btor)) return false;
+
+  start = btor_util_time_stamp ();
+
+  num_workers = btor_opt_get (btor, BTOR_OPT_LS_PORTFOLIO);
+  model       = need_model (btor);
+
+  BTOR_CLR (&portfolio);
+  portfolio.btor        = btor;
+  portfolio.num_workers = num_workers;
+  BTOR_CNEWN (btor->mm, portfolio.workers, num_workers);
+  pthread_mutex_init (&portfolio.mutex, 0);
+
+  BTOR_MSG (btor->msg,
+            1,
+            "solving with a local search portfolio of %u workers",
+            num_workers);
+  btor->stats.ls_portfolio_workers += num_workers;
+
+  /* cloning touches the original instance, hence all clones are created
+   * before any worker is started */
+  for (i = 0; i < num_workers; i++) init_worker (&portfolio, i, model);
+
+  BTOR_NEWN (btor->mm, threads, num_workers - 1);
+  for (i = 1; i < num_workers; i++)
+    pthread_create (&threads[i - 1], 0, thread_work, portfolio.workers + i);
+  /* the calling thread runs the fun engine */
+  run_worker (portfolio.workers);
+  for (i = 1; i < num_workers; i++) pthread_join (threads[i - 1], 0);
+  BTOR_DELETEN (btor->mm, threads, num_workers - 1);
+
+  res    = BTOR_RESULT_UNKNOWN;
+  winner = portfolio.winner;
+  if (winner)
+  {
+    res = winner->result;
+    BTOR_MSG (btor->msg,
+              1,
+              "portfolio worker %u (engine %s) returned %d",
+              (uint32_t) (winner - portfolio.workers),
+              engine_name (winner->engine),
+              res);
+    if (res == BTOR_RESULT_SAT && model) copy_model (btor, winner->clone);
+  }
+  *result = res;
+
+  for (i = 0; i < num_workers; i++) btor_delete (portfolio.workers[i].clone);
+  BTOR_DELETEN (btor->mm, portfolio.workers, num_workers);
+  pthread_mutex_destroy (&portfolio.mutex);
+
+  btor->time.ls_portfolio += btor_util_time_stamp () - start;
+  return true;
+#else
+  (void) btor;
+  (void) result;
+  return false;
+#endif
+}
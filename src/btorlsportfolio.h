@@ -0,0 +1,21 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORLSPORTFOLIO_H_INCLUDED
+#define BTORLSPORTFOLIO_H_INCLUDED
+
+#include <stdbool.h>
+#include "btortypes.h"
+
+/* Solve the current formula with clones of 'btor' running in parallel, one
+ * with engine fun and all others with differently configured local search
+ * engines.  Returns false if the portfolio does not apply, in which case
+ * 'result' is not touched and the formula has to be solved by the configured
+ * engine.  On SAT, the variable assignments of the first worker that found a
+ * model are copied into 'btor->bv_model'. */
+bool btor_ls_portfolio_sat (Btor *btor, BtorSolverResult *result);
+
+#endif
@@ -65,9 +65,445 @@ update_roots_table (Btor *btor,
   }
 }
 
+/*------------------------------------------------------------------------*/
+
+struct BtorLsIndex
+{
+  BtorMemMgr *mm;
+  uint32_t size;           /* number of indexed nodes */
+  BtorNode **nodes;        /* indexed nodes, sorted by id (topologically) */
+  uint32_t max_id;         /* max. id of an indexed node */
+  uint32_t *pos;           /* map: node id -> position + 1 in 'nodes' */
+  uint32_t *parents_start; /* parents of nodes[i] are parents[parents_start[i]]
+                              up to parents[parents_start[i + 1] - 1] */
+  uint32_t *parents;       /* parent positions */
+  bool *is_root;           /* nodes[i] is a constraint or an assumption */
+  bool *dirty;             /* nodes[i] must be recomputed */
+  uint32_t *cone;          /* positions of the nodes recomputed in the last
+                              update, in topological order */
+  BtorBitVector **best;    /* assignment of the variables with the least
+                              number of unsatisfied roots so far */
+  uint32_t best_nroots;    /* number of unsatisfied roots under 'best' */
+};
+
+BtorLsIndex *
+btor_lsutils_index_new (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, j, n;
+  BtorNode *cur;
+  BtorNodePtrStack visit, nodes;
+  BtorIntHashTable *mark;
+  BtorPtrHashTableIterator it;
+  BtorNodeIterator nit;
+  BtorMemMgr *mm;
+  BtorLsIndex *res;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_INIT_STACK (mm, nodes);
+  mark = btor_hashint_table_new (mm);
+
+  /* collect the inputs in the cones of the roots, i.e., the bit-vector
+   * variables and the applications of UFs (all other applications are
+   * eliminated if UFs are supported) */
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_node_real_addr (btor_iter_hashptr_next (&it)));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    btor_hashint_table_add (mark, cur->id);
+    assert (!btor_node_is_apply (cur) || btor_node_is_uf (cur->e[0]));
+    if (btor_node_is_bv_var (cur) || btor_node_is_apply (cur))
+      BTOR_PUSH_STACK (nodes, cur);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  btor_hashint_table_delete (mark);
+
+  /* every node that may be affected by a move is a transitive parent of one
+   * of these inputs */
+  mark = btor_hashint_table_new (mm);
+  while (!BTOR_EMPTY_STACK (nodes))
+    BTOR_PUSH_STACK (visit, BTOR_POP_STACK (nodes));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    assert (btor_node_is_regular (cur));
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    btor_hashint_table_add (mark, cur->id);
+    /* function nodes (e.g., externally referenced function conditionals)
+     * are not in the cones of the roots, all applications on them were
+     * eliminated */
+    if (btor_node_is_fun (cur)) continue;
+    BTOR_PUSH_STACK (nodes, cur);
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      BTOR_PUSH_STACK (visit, btor_iter_parent_next (&nit));
+  }
+  btor_hashint_table_delete (mark);
+  BTOR_RELEASE_STACK (visit);
+
+  qsort (nodes.start,
+         BTOR_COUNT_STACK (nodes),
+         sizeof (BtorNode *),
+         btor_node_compare_by_id_qsort_asc);
+
+  BTOR_CNEW (mm, res);
+  res->mm   = mm;
+  res->size = BTOR_COUNT_STACK (nodes);
+  BTOR_NEWN (mm, res->nodes, res->size);
+  BTOR_NEWN (mm, res->is_root, res->size);
+  BTOR_NEWN (mm, res->dirty, res->size);
+  BTOR_NEWN (mm, res->cone, res->size);
+  BTOR_NEWN (mm, res->parents_start, res->size + 1);
+  res->max_id = res->size ? BTOR_TOP_STACK (nodes)->id : 0;
+  BTOR_CNEWN (mm, res->pos, res->max_id + 1);
+
+  for (i = 0, n = 0; i < res->size; i++)
+  {
+    cur               = BTOR_PEEK_STACK (nodes, i);
+    res->nodes[i]     = cur;
+    res->pos[cur->id] = i + 1;
+    res->is_root[i]   = cur->constraint
+                        || btor_hashptr_table_get (btor->assumptions, cur)
+                        || btor_hashptr_table_get (btor->assumptions,
+                                                   btor_node_invert (cur));
+    res->dirty[i]     = false;
+    btor_iter_parent_init (&nit, cur);
+    while (btor_iter_parent_has_next (&nit))
+      if (!btor_node_is_fun (btor_iter_parent_next (&nit))) n += 1;
+  }
+  BTOR_RELEASE_STACK (nodes);
+
+  BTOR_NEWN (mm, res->parents, n);
+  for (i = 0, n = 0; i < res->size; i++)
+  {
+    res->parents_start[i] = n;
+    btor_iter_parent_init (&nit, res->nodes[i]);
+    while (btor_iter_parent_has_next (&nit))
+    {
+      cur = btor_iter_parent_next (&nit);
+      if (btor_node_is_fun (cur)) continue;
+      j = res->pos[cur->id];
+      assert (j > i + 1);
+      res->parents[n++] = j - 1;
+    }
+  }
+  res->parents_start[res->size] = n;
+
+  return res;
+}
+
+void
+btor_lsutils_index_delete (BtorLsIndex *index)
+{
+  assert (index);
+
+  uint32_t i;
+  BtorMemMgr *mm = index->mm;
+
+  if (index->best)
+  {
+    for (i = 0; i < index->size; i++)
+      if (index->best[i]) btor_bv_free (mm, index->best[i]);
+    BTOR_DELETEN (mm, index->best, index->size);
+  }
+  BTOR_DELETEN (mm, index->nodes, index->size);
+  BTOR_DELETEN (mm, index->is_root, index->size);
+  BTOR_DELETEN (mm, index->dirty, index->size);
+  BTOR_DELETEN (mm, index->cone, index->size);
+  BTOR_DELETEN (mm, index->parents, index->parents_start[index->size]);
+  BTOR_DELETEN (mm, index->parents_start, index->size + 1);
+  BTOR_DELETEN (mm, index->pos, index->max_id + 1);
+  BTOR_DELETE (mm, index);
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_lsutils_index_save_best (Btor *btor, BtorLsIndex *index, uint32_t nroots)
+{
+  assert (btor);
+  assert (index);
+
+  uint32_t i;
+  BtorNode *cur;
+
+  if (!index->size) return;
+  if (index->best && nroots >= index->best_nroots) return;
+
+  if (!index->best) BTOR_CNEWN (index->mm, index->best, index->size);
+  for (i = 0; i < index->size; i++)
+  {
+    cur = index->nodes[i];
+    if (!btor_node_is_bv_var (cur)) continue;
+    if (index->best[i]) btor_bv_free (index->mm, index->best[i]);
+    index->best[i] = btor_bv_copy (index->mm, btor_model_get_bv (btor, cur));
+  }
+  index->best_nroots = nroots;
+}
+
+void
+btor_lsutils_index_restore_best (Btor *btor, BtorLsIndex *index)
+{
+  assert (btor);
+  assert (index);
+
+  uint32_t i;
+
+  if (!index->best) return;
+
+  btor_model_init_bv (btor, &btor->bv_model);
+  btor_model_init_fun (btor, &btor->fun_model);
+  for (i = 0; i < index->size; i++)
+    if (index->best[i])
+      btor_model_add_to_bv (
+          btor, btor->bv_model, index->nodes[i], index->best[i]);
+  btor_model_generate (btor, btor->bv_model, btor->fun_model, false);
+}
+
+/*------------------------------------------------------------------------*/
+
+static inline void
+mark_parents_dirty (BtorLsIndex *index,
+                    uint32_t pos,
+                    uint32_t *lo,
+                    uint32_t *hi)
+{
+  uint32_t i, p;
+
+  for (i = index->parents_start[pos]; i < index->parents_start[pos + 1]; i++)
+  {
+    p = index->parents[i];
+    if (index->dirty[p]) continue;
+    index->dirty[p] = true;
+    if (p < *lo) *lo = p;
+    if (p > *hi) *hi = p;
+  }
+}
+
+void
+btor_lsutils_index_get_cone (BtorLsIndex *index,
+                             BtorNode **inputs,
+                             uint32_t ninputs,
+                             BtorNodePtrStack *cone)
+{
+  assert (index);
+  assert (inputs);
+  assert (cone);
+
+  uint32_t i, pos, lo, hi;
+  BtorNode *exp;
+
+  lo = index->size;
+  hi = 0;
+  for (i = 0; i < ninputs; i++)
+  {
+    exp = inputs[i];
+    assert (btor_node_is_regular (exp));
+    assert ((uint32_t) exp->id <= index->max_id && index->pos[exp->id]);
+    mark_parents_dirty (index, index->pos[exp->id] - 1, &lo, &hi);
+  }
+
+  for (pos = lo; pos <= hi && pos < index->size; pos++)
+  {
+    if (!index->dirty[pos]) continue;
+    index->dirty[pos] = false;
+    BTOR_PUSH_STACK (*cone, index->nodes[pos]);
+    mark_parents_dirty (index, pos, &lo, &hi);
+  }
+}
+
+/* Get a copy of the assignment of 'exp'. */
+static BtorBitVector *
+get_assignment (Btor *btor, BtorIntHashTable *bv_model, BtorNode *exp)
+{
+  BtorNode *real_exp;
+  BtorHashTableData *d;
+
+  real_exp = btor_node_real_addr (exp);
+  if (btor_node_is_bv_const (real_exp))
+    return btor_bv_copy (btor->mm,
+                         btor_node_is_inverted (exp)
+                             ? btor_node_bv_const_get_invbits (real_exp)
+                             : btor_node_bv_const_get_bits (real_exp));
+  d = btor_hashint_map_get (bv_model, real_exp->id);
+  if (!d)
+    return btor_model_recursively_compute_assignment (
+        btor, bv_model, btor->fun_model, exp);
+  if (btor_node_is_inverted (exp)) return btor_bv_not (btor->mm, d->as_ptr);
+  return btor_bv_copy (btor->mm, d->as_ptr);
+}
+
+static BtorBitVectorTuple *
+get_args_assignment (Btor *btor, BtorIntHashTable *bv_model, BtorNode *app)
+{
+  uint32_t i;
+  BtorBitVector *bv;
+  BtorBitVectorTuple *res;
+  BtorArgsIterator it;
+
+  res = btor_bv_new_tuple (btor->mm,
+                           btor_node_args_get_arity (btor, app->e[1]));
+  btor_iter_args_init (&it, app->e[1]);
+  for (i = 0; btor_iter_args_has_next (&it); i++)
+  {
+    bv = get_assignment (btor, bv_model, btor_iter_args_next (&it));
+    btor_bv_add_to_tuple (btor->mm, res, bv, i);
+    btor_bv_free (btor->mm, bv);
+  }
+  return res;
+}
+
+/* The assignment of an application is the value of its UF at the current
+ * arguments.  If the UF has no value there yet, the application keeps its
+ * current assignment (if any), which becomes the value of the UF. */
+static BtorBitVector *
+compute_apply_assignment (Btor *btor,
+                          BtorIntHashTable *bv_model,
+                          BtorNode *app)
+{
+  const BtorBitVector *value;
+  BtorBitVector *res;
+  BtorBitVectorTuple *t;
+  BtorHashTableData *d;
+
+  t     = get_args_assignment (btor, bv_model, app);
+  value = btor_model_get_fun_value (btor, btor->fun_model, app->e[0], t);
+  if (value)
+    res = btor_bv_copy (btor->mm, value);
+  else
+  {
+    d   = btor_hashint_map_get (bv_model, app->id);
+    res = d ? btor_bv_copy (btor->mm, d->as_ptr)
+            : btor_bv_new (btor->mm, btor_node_bv_get_width (btor, app));
+    btor_model_set_fun_value (btor, btor->fun_model, app->e[0], t, res);
+  }
+  btor_bv_free_tuple (btor->mm, t);
+  return res;
+}
+
+/* Set the assignment of input 'exp' to 'ass', update its score and mark its
+ * parents dirty. */
+static void
+update_input (Btor *btor,
+              BtorLsIndex *index,
+              BtorIntHashTable *bv_model,
+              BtorIntHashTable *roots,
+              BtorIntHashTable *score,
+              BtorNode *exp,
+              BtorBitVector *ass,
+              bool update_roots,
+              uint32_t *lo,
+              uint32_t *hi)
+{
+  uint32_t pos;
+  BtorHashTableData *d;
+  BtorMemMgr *mm;
+
+  assert ((uint32_t) exp->id <= index->max_id && index->pos[exp->id]);
+
+  mm  = btor->mm;
+  pos = index->pos[exp->id] - 1;
+
+  /* update model */
+  d = btor_hashint_map_get (bv_model, exp->id);
+  assert (d);
+  if (update_roots && index->is_root[pos] && btor_bv_compare (d->as_ptr, ass))
+  {
+    /* old assignment != new assignment */
+    update_roots_table (btor, roots, exp, ass);
+  }
+  btor_bv_free (mm, d->as_ptr);
+  d->as_ptr = btor_bv_copy (mm, ass);
+  if ((d = btor_hashint_map_get (bv_model, -exp->id)))
+  {
+    btor_bv_free (mm, d->as_ptr);
+    d->as_ptr = btor_bv_not (mm, ass);
+  }
+
+  /* update score */
+  if (score && btor_node_bv_get_width (btor, exp) == 1)
+  {
+    assert (btor_hashint_map_contains (score, btor_node_get_id (exp)));
+    btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl =
+        btor_slsutils_compute_score_node (
+            btor, bv_model, btor->fun_model, score, exp);
+
+    assert (btor_hashint_map_contains (score, -btor_node_get_id (exp)));
+    btor_hashint_map_get (score, -btor_node_get_id (exp))->as_dbl =
+        btor_slsutils_compute_score_node (
+            btor, bv_model, btor->fun_model, score, btor_node_invert (exp));
+  }
+
+  mark_parents_dirty (index, pos, lo, hi);
+}
+
+/* An application 'app' of a UF as input of a move updates the value of the
+ * UF at the current arguments of 'app', and hence the assignment of all
+ * applications of the UF with the same arguments. */
+static void
+update_apply_input (Btor *btor,
+                    BtorLsIndex *index,
+                    BtorIntHashTable *bv_model,
+                    BtorIntHashTable *roots,
+                    BtorIntHashTable *score,
+                    BtorNode *app,
+                    BtorBitVector *ass,
+                    bool update_roots,
+                    uint64_t *stats_updates,
+                    uint32_t *lo,
+                    uint32_t *hi)
+{
+  bool same;
+  BtorNode *cur;
+  BtorBitVectorTuple *t, *tcur;
+  BtorNodeIterator it;
+
+  t = get_args_assignment (btor, bv_model, app);
+  btor_model_set_fun_value (btor, btor->fun_model, app->e[0], t, ass);
+
+  btor_iter_apply_parent_init (&it, app->e[0]);
+  while (btor_iter_apply_parent_has_next (&it))
+  {
+    cur = btor_iter_apply_parent_next (&it);
+    if ((uint32_t) cur->id > index->max_id || !index->pos[cur->id]
+        || !btor_hashint_map_contains (bv_model, cur->id))
+      continue;
+    if (cur != app)
+    {
+      tcur = get_args_assignment (btor, bv_model, cur);
+      same = btor_bv_compare_tuple (t, tcur) == 0;
+      btor_bv_free_tuple (btor->mm, tcur);
+      if (!same) continue;
+    }
+    *stats_updates += 1;
+    update_input (btor,
+                  index,
+                  bv_model,
+                  roots,
+                  score,
+                  cur,
+                  ass,
+                  update_roots,
+                  lo,
+                  hi);
+  }
+  btor_bv_free_tuple (btor->mm, t);
+}
+
 /**
  * Update cone of influence.
  *
+ * The nodes to update are marked dirty in 'index' and recomputed in a single
+ * sweep in topological order.  Parents are only marked dirty if the
+ * assignment of a node changed, or if its score may have changed.
+ *
  * Note: 'roots' will only be updated if 'update_roots' is true.
  *         + PROP engine: always
  *         + SLS  engine: only if an actual move is performed
@@ -81,6 +517,7 @@ update_roots_table (Btor *btor,
  */
 void
 btor_lsutils_update_cone (Btor *btor,
+                          BtorLsIndex *index,
                           BtorIntHashTable *bv_model,
                           BtorIntHashTable *roots,
                           BtorIntHashTable *score,
@@ -95,6 +532,7 @@ btor_lsutils_update_cone (Btor *btor,
   assert (btor);
   assert (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP
           || btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_SLS);
+  assert (index);
   assert (bv_model);
   assert (roots);
   assert (exps);
@@ -106,15 +544,14 @@ btor_lsutils_update_cone (Btor *btor,
   assert (time_update_cone_model_gen);
 
   double start, delta;
-  uint32_t i, j;
+  uint32_t i, j, pos, lo, hi, ncone;
   int32_t id;
-  BtorNode *exp, *cur;
-  BtorNodeIterator nit;
+  bool changed;
+  BtorNode *exp, *cur, *real_e;
   BtorIntHashTableIterator iit;
   BtorHashTableData *d;
-  BtorNodePtrStack stack, cone;
-  BtorIntHashTable *cache;
-  BtorBitVector *bv, *e[3], *ass;
+  BtorBitVector *bv, *ass, *tmp[3];
+  const BtorBitVector *e[3];
   BtorMemMgr *mm;
 
   start = delta = btor_util_time_stamp ();
@@ -140,118 +577,100 @@ btor_lsutils_update_cone (Btor *btor,
   }
 #endif
 
-  /* reset cone ----------------------------------------------------------- */
-
-  BTOR_INIT_STACK (mm, cone);
-  BTOR_INIT_STACK (mm, stack);
-  btor_iter_hashint_init (&iit, exps);
-  while (btor_iter_hashint_has_next (&iit))
-  {
-    exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
-    assert (btor_node_is_regular (exp));
-    assert (btor_node_is_bv_var (exp));
-    BTOR_PUSH_STACK (stack, exp);
-  }
-  cache = btor_hashint_table_new (mm);
-  while (!BTOR_EMPTY_STACK (stack))
-  {
-    cur = BTOR_POP_STACK (stack);
-    assert (btor_node_is_regular (cur));
-    if (btor_hashint_table_contains (cache, cur->id)) continue;
-    btor_hashint_table_add (cache, cur->id);
-    if (!btor_hashint_table_contains (exps, cur->id))
-      BTOR_PUSH_STACK (cone, cur);
-    *stats_updates += 1;
-
-    /* push parents */
-    btor_iter_parent_init (&nit, cur);
-    while (btor_iter_parent_has_next (&nit))
-      BTOR_PUSH_STACK (stack, btor_iter_parent_next (&nit));
-  }
-  BTOR_RELEASE_STACK (stack);
-  btor_hashint_table_delete (cache);
+  /* update assignment and score of exps, mark their parents dirty -------- */
 
-  *time_update_cone_reset += btor_util_time_stamp () - delta;
-
-  /* update assignment and score of exps ----------------------------------- */
+  lo = index->size;
+  hi = 0;
 
   btor_iter_hashint_init (&iit, exps);
   while (btor_iter_hashint_has_next (&iit))
   {
     ass = (BtorBitVector *) exps->data[iit.cur_pos].as_ptr;
     exp = btor_node_get_by_id (btor, btor_iter_hashint_next (&iit));
-
-    /* update model */
-    d = btor_hashint_map_get (bv_model, exp->id);
-    assert (d);
-    if (update_roots
-        && (exp->constraint || btor_hashptr_table_get (btor->assumptions, exp)
-            || btor_hashptr_table_get (btor->assumptions,
-                                       btor_node_invert (exp)))
-        && btor_bv_compare (d->as_ptr, ass))
-    {
-      /* old assignment != new assignment */
-      update_roots_table (btor, roots, exp, ass);
-    }
-    btor_bv_free (mm, d->as_ptr);
-    d->as_ptr = btor_bv_copy (mm, ass);
-    if ((d = btor_hashint_map_get (bv_model, -exp->id)))
+    assert (btor_node_is_regular (exp));
+    assert (btor_node_is_bv_var (exp) || btor_node_is_apply (exp));
+    if (btor_node_is_apply (exp))
     {
-      btor_bv_free (mm, d->as_ptr);
-      d->as_ptr = btor_bv_not (mm, ass);
+      update_apply_input (btor,
+                          index,
+                          bv_model,
+                          roots,
+                          score,
+                          exp,
+                          ass,
+                          update_roots,
+                          stats_updates,
+                          &lo,
+                          &hi);
     }
-
-    /* update score */
-    if (score && btor_node_bv_get_width (btor, exp) == 1)
+    else
     {
-      assert (btor_hashint_map_contains (score, btor_node_get_id (exp)));
-      btor_hashint_map_get (score, btor_node_get_id (exp))->as_dbl =
-          btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, exp);
-
-      assert (btor_hashint_map_contains (score, -btor_node_get_id (exp)));
-      btor_hashint_map_get (score, -btor_node_get_id (exp))->as_dbl =
-          btor_slsutils_compute_score_node (
-              btor, bv_model, btor->fun_model, score, btor_node_invert (exp));
+      *stats_updates += 1;
+      update_input (btor,
+                    index,
+                    bv_model,
+                    roots,
+                    score,
+                    exp,
+                    ass,
+                    update_roots,
+                    &lo,
+                    &hi);
     }
   }
 
-  qsort (cone.start,
-         BTOR_COUNT_STACK (cone),
-         sizeof (BtorNode *),
-         btor_node_compare_by_id_qsort_asc);
+  *time_update_cone_reset += btor_util_time_stamp () - delta;
 
   /* update model of cone ------------------------------------------------- */
 
   delta = btor_util_time_stamp ();
 
-  for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+  /* parents have a higher position than their children, hence all dirty
+   * nodes are between 'lo' and 'hi' */
+  ncone = 0;
+  for (pos = lo; pos <= hi && pos < index->size; pos++)
   {
-    cur = BTOR_PEEK_STACK (cone, i);
+    if (!index->dirty[pos]) continue;
+    index->dirty[pos] = false;
+    cur               = index->nodes[pos];
     assert (btor_node_is_regular (cur));
+
+    /* arguments have no assignment, their applications are recomputed */
+    if (btor_node_is_args (cur))
+    {
+      mark_parents_dirty (index, pos, &lo, &hi);
+      continue;
+    }
+
+    *stats_updates += 1;
+
+    if (btor_node_is_apply (cur))
+    {
+      bv = compute_apply_assignment (btor, bv_model, cur);
+      goto UPDATE;
+    }
+
     for (j = 0; j < cur->arity; j++)
     {
-      if (btor_node_is_bv_const (cur->e[j]))
+      tmp[j] = 0;
+      real_e = btor_node_real_addr (cur->e[j]);
+      if (btor_node_is_bv_const (real_e))
       {
-        e[j] =
-            btor_node_is_inverted (cur->e[j])
-                ? btor_bv_copy (mm, btor_node_bv_const_get_invbits (cur->e[j]))
-                : btor_bv_copy (mm, btor_node_bv_const_get_bits (cur->e[j]));
+        e[j] = btor_node_is_inverted (cur->e[j])
+                   ? btor_node_bv_const_get_invbits (real_e)
+                   : btor_node_bv_const_get_bits (real_e);
+        continue;
       }
+      d = btor_hashint_map_get (bv_model, real_e->id);
+      /* Note: generate model enabled branch for ite (and does not
+       * generate model for nodes in the branch, hence !b may happen */
+      if (!d)
+        e[j] = tmp[j] = btor_model_recursively_compute_assignment (
+            btor, bv_model, btor->fun_model, cur->e[j]);
+      else if (btor_node_is_inverted (cur->e[j]))
+        e[j] = tmp[j] = btor_bv_not (mm, d->as_ptr);
       else
-      {
-        d = btor_hashint_map_get (bv_model,
-                                  btor_node_real_addr (cur->e[j])->id);
-        /* Note: generate model enabled branch for ite (and does not
-         * generate model for nodes in the branch, hence !b may happen */
-        if (!d)
-          e[j] = btor_model_recursively_compute_assignment (
-              btor, bv_model, btor->fun_model, cur->e[j]);
-        else
-          e[j] = btor_node_is_inverted (cur->e[j])
-                     ? btor_bv_not (mm, d->as_ptr)
-                     : btor_bv_copy (mm, d->as_ptr);
-      }
+        e[j] = d->as_ptr;
     }
     switch (cur->kind)
     {
@@ -276,26 +695,28 @@ btor_lsutils_update_cone (Btor *btor,
         bv = btor_bv_is_true (e[0]) ? btor_bv_copy (mm, e[1])
                                     : btor_bv_copy (mm, e[2]);
     }
+    /* cleanup */
+    for (j = 0; j < cur->arity; j++)
+      if (tmp[j]) btor_bv_free (mm, tmp[j]);
 
+  UPDATE:
     /* update assignment */
 
     d = btor_hashint_map_get (bv_model, cur->id);
 
+    changed = !d || btor_bv_compare (d->as_ptr, bv);
+
     /* update roots table */
-    if (update_roots
-        && (cur->constraint || btor_hashptr_table_get (btor->assumptions, cur)
-            || btor_hashptr_table_get (btor->assumptions,
-                                       btor_node_invert (cur))))
+    if (update_roots && index->is_root[pos])
     {
       assert (d); /* must be contained, is root */
       /* old assignment != new assignment */
-      if (btor_bv_compare (d->as_ptr, bv))
-        update_roots_table (btor, roots, cur, bv);
+      if (changed) update_roots_table (btor, roots, cur, bv);
     }
 
     /* update assignments */
     /* Note: generate model enabled branch for ite (and does not generate
-     *       model for nodes in the branch, hence !b may happen */
+     * model for nodes in the branch, hence !b may happen */
     if (!d)
     {
       btor_node_copy (btor, cur);
@@ -312,8 +733,12 @@ btor_lsutils_update_cone (Btor *btor,
       btor_bv_free (mm, d->as_ptr);
       d->as_ptr = btor_bv_not (mm, bv);
     }
-    /* cleanup */
-    for (j = 0; j < cur->arity; j++) btor_bv_free (mm, e[j]);
+
+    index->cone[ncone++] = pos;
+
+    /* the score of a node depends on the scores of its children */
+    if (changed || (score && btor_node_bv_get_width (btor, cur) == 1))
+      mark_parents_dirty (index, pos, &lo, &hi);
   }
   *time_update_cone_model_gen += btor_util_time_stamp () - delta;
 
@@ -322,9 +747,9 @@ btor_lsutils_update_cone (Btor *btor,
   if (score)
   {
     delta = btor_util_time_stamp ();
-    for (i = 0; i < BTOR_COUNT_STACK (cone); i++)
+    for (i = 0; i < ncone; i++)
     {
-      cur = BTOR_PEEK_STACK (cone, i);
+      cur = index->nodes[index->cone[i]];
       assert (btor_node_is_regular (cur));
 
       if (btor_node_bv_get_width (btor, cur) != 1) continue;
@@ -347,8 +772,6 @@ btor_lsutils_update_cone (Btor *btor,
     *time_update_cone_compute_score += btor_util_time_stamp () - delta;
   }
 
-  BTOR_RELEASE_STACK (cone);
-
 #ifndef NDEBUG
   btor_iter_hashptr_init (&pit, btor->unsynthesized_constraints);
   btor_iter_hashptr_queue (&pit, btor->assumptions);
@@ -9,9 +9,47 @@
 #ifndef BTORLSUTILS_H_INCLUDED
 #define BTORLSUTILS_H_INCLUDED
 
+#include "btornode.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
 
+typedef struct BtorLsIndex BtorLsIndex;
+
+/**
+ * Create a topologically sorted index of all nodes that may be affected by
+ * a local search move, i.e., of all transitive parents of the bit-vector
+ * variables in the cones of the current constraints and assumptions.
+ * The index is only valid as long as no nodes are added or deleted.
+ */
+BtorLsIndex* btor_lsutils_index_new (Btor* btor);
+
+void btor_lsutils_index_delete (BtorLsIndex* index);
+
+/**
+ * Save the current assignment of the bit-vector variables in 'index' if it
+ * leaves fewer roots unsatisfied ('nroots') than the best assignment saved
+ * so far.
+ */
+void btor_lsutils_index_save_best (Btor* btor,
+                                   BtorLsIndex* index,
+                                   uint32_t nroots);
+
+/**
+ * Replace the current model with the best assignment saved in 'index'
+ * (if any), e.g., when local search gives up.
+ */
+void btor_lsutils_index_restore_best (Btor* btor, BtorLsIndex* index);
+
+/**
+ * Collect the nodes in 'index' that would be recomputed if the assignments
+ * of the given 'inputs' changed, i.e., their transitive parents, in
+ * topological order.
+ */
+void btor_lsutils_index_get_cone (BtorLsIndex* index,
+                                  BtorNode** inputs,
+                                  uint32_t ninputs,
+                                  BtorNodePtrStack* cone);
+
 /**
  * Update cone of incluence as a consequence of a local search move.
  *
@@ -21,6 +59,7 @@
  *                        (not during neighborhood exploration, 'try_move')
  */
 void btor_lsutils_update_cone (Btor* btor,
+                               BtorLsIndex* index,
                                BtorIntHashTable* bv_model,
                                BtorIntHashTable* roots,
                                BtorIntHashTable* score,
@@ -0,0 +1,287 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+/* Generates the rewrite rule candidate tables (btorrwtable.h) used by
+ * btorrewrite.c to skip rules that can not apply to the operands at hand.
+ *
+ * For every rule we specify necessary conditions on the feature (class and
+ * polarity, see btorrwrules.h) of each operand, and on the relation between
+ * the compared operands.  A rule is a candidate for a given combination of
+ * operand features if all of its conditions are met.  Rules that are not
+ * listed below are always candidates.
+ *
+ * Note: Conditions must be implied by the corresponding applies_* function,
+ *       which is checked in debug mode whenever a rule is skipped. */
+
+#include "btorrwrules.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*------------------------------------------------------------------------*/
+
+#define RULE(r) BTOR_RW_RULE_##r
+
+/* operand conditions */
+#define A 0xffffffffu
+#define R(c) (1u << BTOR_RW_OP_##c)
+#define I(c) (1u << (BTOR_RW_OP_##c + (1u << BTOR_RW_OP_CLASS_BITS)))
+#define C(c) (R (c) | I (c))
+
+/* relation conditions */
+#define SAME (1u << BTOR_RW_REL_SAME)
+#define NEG (1u << BTOR_RW_REL_NEG)
+
+struct BtorRwRuleSpec
+{
+  BtorRwRule rule;
+  uint32_t ops[3];
+  uint32_t rel;
+};
+typedef struct BtorRwRuleSpec BtorRwRuleSpec;
+
+static const BtorRwRuleSpec spec[] = {
+    /* slice */
+    {RULE (const_slice), {C (CONST), A, A}, A},
+    {RULE (slice_slice), {C (SLICE), A, A}, A},
+    {RULE (concat_lower_slice), {C (CONCAT), A, A}, A},
+    {RULE (concat_upper_slice), {C (CONCAT), A, A}, A},
+    {RULE (concat_rec_upper_slice), {C (CONCAT), A, A}, A},
+    {RULE (concat_rec_lower_slice), {C (CONCAT), A, A}, A},
+    {RULE (concat_rec_slice), {C (CONCAT), A, A}, A},
+    {RULE (and_slice), {C (AND), A, A}, A},
+    {RULE (bcond_slice), {C (COND), A, A}, A},
+    {RULE (zero_lower_slice), {C (MUL) | C (ADD), A, A}, A},
+    /* binary */
+    {RULE (const_binary_exp), {C (CONST), C (CONST), A}, A},
+    {RULE (special_const_lhs_binary_exp), {C (CONST), ~C (CONST), A}, A},
+    {RULE (special_const_rhs_binary_exp), {~C (CONST), C (CONST), A}, A},
+    /* eq */
+    {RULE (true_eq), {A, A, A}, SAME},
+    {RULE (bcond_eq), {C (COND), C (COND), A}, A},
+    {RULE (add_left_eq), {R (ADD), A, A}, A},
+    {RULE (add_right_eq), {R (ADD), A, A}, A},
+    {RULE (add_add_1_eq), {R (ADD), R (ADD), A}, A},
+    {RULE (add_add_2_eq), {R (ADD), R (ADD), A}, A},
+    {RULE (add_add_3_eq), {R (ADD), R (ADD), A}, A},
+    {RULE (add_add_4_eq), {R (ADD), R (ADD), A}, A},
+    {RULE (sub_eq), {A, R (ADD), A}, A},
+    {RULE (bcond_uneq_if_eq), {R (COND), A, A}, A},
+    {RULE (bcond_uneq_else_eq), {R (COND), A, A}, A},
+    {RULE (bcond_if_eq), {A, C (COND), A}, A},
+    {RULE (bcond_else_eq), {A, C (COND), A}, A},
+    {RULE (distrib_add_mul_eq), {R (MUL), R (ADD), A}, A},
+    {RULE (concat_eq), {C (CONCAT), A, A}, A},
+    /* ult */
+    {RULE (false_ult), {A, A, A}, SAME},
+    {RULE (concat_upper_ult), {R (CONCAT), R (CONCAT), A}, A},
+    {RULE (concat_lower_ult), {R (CONCAT), R (CONCAT), A}, A},
+    {RULE (bcond_ult), {C (COND), C (COND), A}, A},
+    /* and */
+    {RULE (idem1_and), {A, A, A}, SAME},
+    {RULE (contr1_and), {A, A, A}, NEG},
+    {RULE (contr2_and), {R (AND), R (AND), A}, A},
+    {RULE (idem2_and), {R (AND), R (AND), A}, A},
+    {RULE (comm_and), {R (AND), R (AND), A}, A},
+    {RULE (bool_xnor_and), {I (AND), I (AND), A}, A},
+    {RULE (resol1_and), {I (AND), I (AND), A}, A},
+    {RULE (resol2_and), {I (AND), I (AND), A}, A},
+    {RULE (ult_false_and), {R (ULT), R (ULT), A}, A},
+    {RULE (ult_and), {I (ULT), I (ULT), A}, A},
+    {RULE (subsum1_and), {R (AND), I (AND), A}, A},
+    {RULE (subst1_and), {R (AND), I (AND), A}, A},
+    {RULE (subst2_and), {R (AND), I (AND), A}, A},
+    {RULE (subsum2_and), {I (AND), A, A}, A},
+    {RULE (subst3_and), {I (AND), A, A}, A},
+    {RULE (subst4_and), {I (AND), A, A}, A},
+    {RULE (contr3_and), {R (AND), A, A}, A},
+    {RULE (idem3_and), {R (AND), A, A}, A},
+    {RULE (const1_and), {R (AND), C (CONST), A}, A},
+    {RULE (const2_and), {R (AND), C (CONST), A}, A},
+    {RULE (concat_and), {C (CONCAT), C (CONCAT), A}, A},
+    /* add */
+    {RULE (mult_add), {A, A, A}, SAME},
+    {RULE (not_add), {A, A, A}, NEG},
+    {RULE (bcond_add), {C (COND), C (COND), A}, A},
+    {RULE (neg_add), {A, R (ADD), A}, A},
+    {RULE (zero_add), {C (CONST), A, A}, A},
+    {RULE (const_lhs_add), {C (CONST), R (ADD), A}, A},
+    {RULE (const_rhs_add), {C (CONST), R (ADD), A}, A},
+    {RULE (const_neg_lhs_add), {I (MUL), A, A}, A},
+    {RULE (const_neg_rhs_add), {I (MUL), A, A}, A},
+    {RULE (push_ite_add), {R (COND), A, A}, A},
+    {RULE (sll_add), {A, R (SLL), A}, A},
+    /* mul */
+    {RULE (bcond_mul), {C (COND), C (COND), A}, A},
+    {RULE (const_lhs_mul), {C (CONST), R (MUL), A}, A},
+    {RULE (const_rhs_mul), {C (CONST), R (MUL), A}, A},
+    {RULE (const_mul), {C (CONST), R (ADD), A}, A},
+    {RULE (push_ite_mul), {R (COND), A, A}, A},
+    {RULE (sll_mul), {R (SLL), A, A}, A},
+    {RULE (neg_mul), {R (ADD), R (ADD), A}, A},
+    /* udiv, urem */
+    {RULE (power2_udiv), {A, R (CONST), A}, A},
+    {RULE (one_udiv), {A, A, A}, SAME},
+    {RULE (bcond_udiv), {C (COND), C (COND), A}, A},
+    {RULE (zero_urem), {A, A, A}, SAME},
+    /* concat */
+    {RULE (const_concat), {C (CONCAT), C (CONST), A}, A},
+    {RULE (slice_concat), {C (SLICE), C (SLICE), A}, A},
+    {RULE (and_lhs_concat), {C (AND), A, A}, A},
+    {RULE (and_rhs_concat), {A, C (AND), A}, A},
+    /* shifts */
+    {RULE (const_sll), {A, C (CONST), A}, A},
+    {RULE (const_srl), {A, C (CONST), A}, A},
+    /* apply */
+    {RULE (const_lambda_apply), {R (LAMBDA), A, A}, A},
+    {RULE (param_lambda_apply), {R (LAMBDA), A, A}, A},
+    {RULE (apply_apply), {R (LAMBDA), A, A}, A},
+    {RULE (prop_apply_lambda), {R (LAMBDA), A, A}, A},
+    {RULE (prop_apply_update), {R (UPDATE), A, A}, A},
+    /* quantifiers */
+    {RULE (eq_forall), {A, C (EQ), A}, A},
+    {RULE (eq_exists), {A, C (EQ), A}, A},
+    /* cond */
+    {RULE (equal_branches_cond), {A, A, A}, SAME},
+    {RULE (const_cond), {C (CONST), A, A}, A},
+    {RULE (cond_if_dom_cond), {A, C (COND), A}, A},
+    {RULE (cond_if_merge_if_cond), {A, C (COND), A}, A},
+    {RULE (cond_if_merge_else_cond), {A, C (COND), A}, A},
+    {RULE (cond_else_dom_cond), {A, A, C (COND)}, A},
+    {RULE (cond_else_merge_if_cond), {A, A, C (COND)}, A},
+    {RULE (cond_else_merge_else_cond), {A, A, C (COND)}, A},
+    {RULE (add_if_cond), {A, R (ADD), A}, A},
+    {RULE (add_else_cond), {A, A, R (ADD)}, A},
+    {RULE (concat_cond), {A, C (CONCAT), C (CONCAT)}, A},
+    {RULE (op_lhs_cond),
+     {A,
+      R (ADD) | R (AND) | R (MUL) | R (UDIV) | R (UREM),
+      R (ADD) | R (AND) | R (MUL) | R (UDIV) | R (UREM)},
+     A},
+    {RULE (op_rhs_cond),
+     {A,
+      R (ADD) | R (AND) | R (MUL) | R (UDIV) | R (UREM),
+      R (ADD) | R (AND) | R (MUL) | R (UDIV) | R (UREM)},
+     A},
+    {RULE (comm_op_1_cond),
+     {A, R (ADD) | R (AND) | R (MUL), R (ADD) | R (AND) | R (MUL)},
+     A},
+    {RULE (comm_op_2_cond),
+     {A, R (ADD) | R (AND) | R (MUL), R (ADD) | R (AND) | R (MUL)},
+     A},
+};
+
+/*------------------------------------------------------------------------*/
+
+static uint64_t cand_op[3][BTOR_RW_NUM_OP_FEATURES][BTOR_RW_CAND_WORDS];
+static uint64_t cand_rel[BTOR_RW_NUM_OP_RELS][BTOR_RW_CAND_WORDS];
+
+static void
+print_words (FILE *file, const uint64_t *words)
+{
+  uint32_t i;
+  fputs ("{", file);
+  for (i = 0; i < BTOR_RW_CAND_WORDS; i++)
+    fprintf (file,
+             "%s0x%016llxull",
+             i ? ", " : "",
+             (unsigned long long) words[i]);
+  fputs ("}", file);
+}
+
+int
+main (int argc, char **argv)
+{
+  FILE *file;
+  uint32_t i, j, f, r, w;
+  uint64_t bit;
+  uint32_t ops[BTOR_RW_NUM_RULES][3], rel[BTOR_RW_NUM_RULES];
+  char seen[BTOR_RW_NUM_RULES];
+
+  if (argc != 2)
+  {
+    fprintf (stderr, "usage: btormkrwtable <output file>\n");
+    return EXIT_FAILURE;
+  }
+
+  /* all rules are candidates unless specified otherwise */
+  memset (seen, 0, sizeof (seen));
+  for (r = 0; r < BTOR_RW_NUM_RULES; r++)
+  {
+    ops[r][0] = ops[r][1] = ops[r][2] = A;
+    rel[r]                            = A;
+  }
+  for (i = 0; i < sizeof (spec) / sizeof (*spec); i++)
+  {
+    r = spec[i].rule;
+    if (seen[r])
+    {
+      fprintf (stderr, "btormkrwtable: duplicate rule %u\n", r);
+      return EXIT_FAILURE;
+    }
+    seen[r] = 1;
+    for (j = 0; j < 3; j++) ops[r][j] = spec[i].ops[j];
+    rel[r] = spec[i].rel;
+  }
+
+  for (r = 0; r < BTOR_RW_NUM_RULES; r++)
+  {
+    w   = r / 64;
+    bit = UINT64_C (1) << (r % 64);
+    for (j = 0; j < 3; j++)
+      for (f = 0; f < BTOR_RW_NUM_OP_FEATURES; f++)
+        if (ops[r][j] & (1u << f)) cand_op[j][f][w] |= bit;
+    for (f = 0; f < BTOR_RW_NUM_OP_RELS; f++)
+      if (rel[r] & (1u << f)) cand_rel[f][w] |= bit;
+  }
+
+  if (!(file = fopen (argv[1], "w")))
+  {
+    fprintf (stderr, "btormkrwtable: can not write '%s'\n", argv[1]);
+    return EXIT_FAILURE;
+  }
+
+  fputs ("/* Generated by btormkrwtable, do not edit. */\n\n", file);
+  fputs ("#ifndef BTORRWTABLE_H_INCLUDED\n", file);
+  fputs ("#define BTORRWTABLE_H_INCLUDED\n\n", file);
+  fputs ("#include \"btorrwrules.h\"\n\n", file);
+  fputs ("#include <stdint.h>\n\n", file);
+
+  fputs ("/* rule candidates per operand position and operand feature */\n",
+         file);
+  fputs ("static const uint64_t g_btor_rw_cand_op[3][BTOR_RW_NUM_OP_FEATURES]"
+         "[BTOR_RW_CAND_WORDS] = {\n",
+         file);
+  for (j = 0; j < 3; j++)
+  {
+    fputs ("  {\n", file);
+    for (f = 0; f < BTOR_RW_NUM_OP_FEATURES; f++)
+    {
+      fputs ("    ", file);
+      print_words (file, cand_op[j][f]);
+      fputs (",\n", file);
+    }
+    fputs ("  },\n", file);
+  }
+  fputs ("};\n\n", file);
+
+  fputs ("/* rule candidates per operand relation */\n", file);
+  fputs ("static const uint64_t g_btor_rw_cand_rel[BTOR_RW_NUM_OP_RELS]"
+         "[BTOR_RW_CAND_WORDS] = {\n",
+         file);
+  for (f = 0; f < BTOR_RW_NUM_OP_RELS; f++)
+  {
+    fputs ("  ", file);
+    print_words (file, cand_rel[f]);
+    fputs (",\n", file);
+  }
+  fputs ("};\n\n#endif\n", file);
+
+  fclose (file);
+  return EXIT_SUCCESS;
+}
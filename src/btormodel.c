@@ -466,6 +466,59 @@ btor_model_get_fun (Btor *btor, BtorNode *exp)
   return btor_model_get_fun_aux (btor, btor->bv_model, btor->fun_model, exp);
 }
 
+const BtorBitVector *
+btor_model_get_fun_value (Btor *btor,
+                          BtorIntHashTable *fun_model,
+                          BtorNode *fun,
+                          BtorBitVectorTuple *t)
+{
+  assert (btor);
+  assert (fun_model);
+  assert (fun);
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_fun (fun));
+  assert (t);
+
+  BtorHashTableData *d;
+  BtorPtrHashBucket *b;
+
+  (void) btor;
+
+  d = btor_hashint_map_get (fun_model, fun->id);
+  if (!d) return 0;
+  b = btor_hashptr_table_get ((BtorPtrHashTable *) d->as_ptr, t);
+  if (!b) return 0;
+  return (BtorBitVector *) b->data.as_ptr;
+}
+
+void
+btor_model_set_fun_value (Btor *btor,
+                          BtorIntHashTable *fun_model,
+                          BtorNode *fun,
+                          BtorBitVectorTuple *t,
+                          BtorBitVector *value)
+{
+  assert (btor);
+  assert (fun_model);
+  assert (fun);
+  assert (btor_node_is_regular (fun));
+  assert (btor_node_is_fun (fun));
+  assert (t);
+  assert (value);
+
+  BtorHashTableData *d;
+  BtorPtrHashBucket *b;
+
+  d = btor_hashint_map_get (fun_model, fun->id);
+  if (d && (b = btor_hashptr_table_get ((BtorPtrHashTable *) d->as_ptr, t)))
+  {
+    btor_bv_free (btor->mm, b->data.as_ptr);
+    b->data.as_ptr = btor_bv_copy (btor->mm, value);
+  }
+  else
+    add_to_fun_model (btor, fun_model, fun, t, value);
+}
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -61,6 +61,21 @@ const BtorPtrHashTable* btor_model_get_fun_aux (Btor* btor,
                                                 BtorIntHashTable* fun_model,
                                                 BtorNode* exp);
 
+/* Get the value of function 'fun' for arguments 't' in 'fun_model', or 0 if
+ * 't' has no value (the result is not copied). */
+const BtorBitVector* btor_model_get_fun_value (Btor* btor,
+                                               BtorIntHashTable* fun_model,
+                                               BtorNode* fun,
+                                               BtorBitVectorTuple* t);
+
+/* Set the value of function 'fun' for arguments 't' in 'fun_model',
+ * overwrites an existing value for 't'. */
+void btor_model_set_fun_value (Btor* btor,
+                               BtorIntHashTable* fun_model,
+                               BtorNode* fun,
+                               BtorBitVectorTuple* t,
+                               BtorBitVector* value);
+
 /*------------------------------------------------------------------------*/
 
 void btor_model_add_to_bv (Btor* btor,
@@ -142,6 +142,26 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "incremental usage");
+  init_opt (btor,
+            BTOR_OPT_ACTLIT_SCOPES,
+            false,
+            true,
+            "actlit-scopes",
+            0,
+            1,
+            0,
+            1,
+            "use activation literals for push/pop");
+  init_opt (btor,
+            BTOR_OPT_INCREMENTAL_SIMP,
+            false,
+            true,
+            "incremental-simp",
+            0,
+            1,
+            0,
+            1,
+            "incremental-safe simplifications");
   init_opt (btor,
             BTOR_OPT_INCREMENTAL_SMT1,
             false,
@@ -342,6 +362,17 @@ btor_opt_init_opts (Btor *btor)
                 BTOR_SAT_ENGINE_PICOSAT,
                 "use picosat as back end SAT solver");
   btor->options[BTOR_OPT_SAT_ENGINE].options = opts;
+  init_opt (btor,
+            BTOR_OPT_SAT_GC,
+            false,
+            false,
+            "sat-gc",
+            0,
+            0,
+            0,
+            100,
+            "rebuild SAT instance if given percentage of CNF variables "
+            "is dead");
 
   init_opt (btor,
             BTOR_OPT_AUTO_CLEANUP,
@@ -415,6 +446,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             3,
             "rewrite level");
+  init_opt (btor,
+            BTOR_OPT_REWRITE_PROFILE,
+            false,
+            false,
+            "rewrite-profile",
+            "rwp",
+            0,
+            0,
+            2,
+            "profile rewrite rules (2: with time statistics)");
   init_opt (btor,
             BTOR_OPT_SKELETON_PREPROC,
             false,
@@ -435,6 +476,17 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "add ackermann constraints");
+  init_opt (btor,
+            BTOR_OPT_ACKERMANN_BUCKETS,
+            false,
+            true,
+            "ackermannize-buckets",
+            "ack-b",
+            0,
+            0,
+            1,
+            "only add ackermann constraints for applications with "
+            "arguments that are not known to be distinct");
   init_opt (btor,
             BTOR_OPT_BETA_REDUCE,
             false,
@@ -456,6 +508,16 @@ btor_opt_init_opts (Btor *btor)
                 BTOR_BETA_REDUCE_ALL,
                 "beta-reduce functions and array-writes");
   btor->options[BTOR_OPT_BETA_REDUCE].options = opts;
+  init_opt (btor,
+            BTOR_OPT_BETA_REDUCE_CACHE,
+            false,
+            false,
+            "beta-reduce-cache",
+            0,
+            100000,
+            0,
+            UINT32_MAX,
+            "max. number of beta reduction results kept across calls");
 
   init_opt (btor,
             BTOR_OPT_ELIMINATE_SLICES,
@@ -507,6 +569,76 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "extract lambda terms");
+  init_opt (btor,
+            BTOR_OPT_ABSINT,
+            false,
+            true,
+            "absint",
+            "ai",
+            0,
+            0,
+            1,
+            "simplify with fixed bits and intervals of bit-vector terms");
+  init_opt (btor,
+            BTOR_OPT_SIMP_TIME_BUDGET,
+            false,
+            false,
+            "simp-time-budget",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "time budget in ms for optional simplification passes");
+  init_opt (btor,
+            BTOR_OPT_SIMP_PASS_BUDGET,
+            false,
+            false,
+            "simp-pass-budget",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "time budget in ms per optional simplification pass");
+  init_opt (btor,
+            BTOR_OPT_SIMP_SKIP_UNPRODUCTIVE,
+            false,
+            false,
+            "simp-skip-unproductive",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "skip simplification passes without reduction in the last n runs");
+  init_opt (btor,
+            BTOR_OPT_DECOMPOSE,
+            false,
+            false,
+            "decompose",
+            0,
+            0,
+            0,
+            BTOR_DECOMPOSE_MAX_THREADS,
+            "solve independent sub-problems with n worker threads");
+  init_opt (btor,
+            BTOR_OPT_BW_REDUCE,
+            false,
+            false,
+            "bw-reduce",
+            0,
+            0,
+            0,
+            UINT32_MAX,
+            "solve with variables restricted to n bits first");
+  init_opt (btor,
+            BTOR_OPT_LS_PORTFOLIO,
+            false,
+            false,
+            "ls-portfolio",
+            0,
+            0,
+            0,
+            BTOR_LS_PORTFOLIO_MAX_THREADS,
+            "solve with a portfolio of n local search and fun engine threads");
   init_opt (btor,
             BTOR_OPT_NORMALIZE_ADD,
             false,
@@ -551,6 +683,17 @@ btor_opt_init_opts (Btor *btor)
             1,
             "run sls engine as preprocessing within a sequential portfolio "
             "(QF_BV only)");
+  init_opt (btor,
+            BTOR_OPT_FUN_PRESEED,
+            false,
+            true,
+            "fun-preseed",
+            0,
+            0,
+            0,
+            1,
+            "seed SAT solver phases with the best assignment of fun-preprop "
+            "or fun-presls");
   init_opt (btor,
             BTOR_OPT_FUN_DUAL_PROP,
             false,
@@ -668,6 +811,17 @@ btor_opt_init_opts (Btor *btor)
                 "generate lemmas for all conflicts");
   btor->options[BTOR_OPT_FUN_EAGER_LEMMAS].options  = opts;
 
+  init_opt (btor,
+            BTOR_OPT_FUN_KEEP_LEMMAS,
+            false,
+            true,
+            "fun-keep-lemmas",
+            "fun-kl",
+            0,
+            0,
+            1,
+            "keep assumed lemmas across satisfiability checks");
+
   init_opt (btor,
             BTOR_OPT_FUN_STORE_LAMBDAS,
             false,
@@ -884,6 +1038,16 @@ btor_opt_init_opts (Btor *btor)
             1,
             "use prev. neighbor with better score as base for "
             "next move test");
+  init_opt (btor,
+            BTOR_OPT_SLS_MOVE_LANES,
+            false,
+            true,
+            "sls-move-lanes",
+            0,
+            1,
+            0,
+            1,
+            "try neighbors bit-parallel");
   init_opt (btor,
             BTOR_OPT_SLS_USE_RESTARTS,
             false,
@@ -1248,6 +1412,16 @@ btor_opt_init_opts (Btor *btor)
             0,
             1,
             "synthesize quantifier instantiations from counterexamples");
+  init_opt (btor,
+            BTOR_OPT_QUANT_WORKERS,
+            false,
+            false,
+            "quant-workers",
+            0,
+            0,
+            0,
+            BTOR_QUANT_MAX_WORKERS,
+            "number of additional cegqi worker threads");
 
   /* internal options ---------------------------------------------------- */
   init_opt (btor,
@@ -1634,7 +1808,8 @@ btor_opt_set (Btor *btor, const BtorOption opt, uint32_t val)
                 "is enabled");
       val = 0;
     }
-    assert (!val || !btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
+    assert (!val || !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+            || btor_opt_get (btor, BTOR_OPT_INCREMENTAL_SIMP));
   }
   else if (opt == BTOR_OPT_SAT_ENGINE)
   {
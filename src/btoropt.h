@@ -62,6 +62,12 @@ typedef struct BtorOptHelp BtorOptHelp;
 
 #define BTOR_PROB_MAX 1000
 
+#define BTOR_DECOMPOSE_MAX_THREADS 64
+
+#define BTOR_LS_PORTFOLIO_MAX_THREADS 64
+
+#define BTOR_QUANT_MAX_WORKERS 64
+
 /* enums for option values are defined in btortypes.h */
 
 #define BTOR_SAT_ENGINE_MIN BTOR_SAT_ENGINE_LINGELING
@@ -1687,6 +1687,164 @@ check_result_binary_dbg (Btor *btor,
 }
 #endif
 
+/* ========================================================================== */
+/* Inverse value cache                                                        */
+/* ========================================================================== */
+
+struct BtorPropInvKey
+{
+  BtorNodeKind kind;
+  int32_t eidx;
+  BtorBitVector *bvexp;
+  BtorBitVector *bve;
+};
+
+typedef struct BtorPropInvKey BtorPropInvKey;
+
+struct BtorPropInvCache
+{
+  BtorMemMgr *mm;
+  BtorPtrHashTable *cache; /* BtorPropInvKey -> BtorBitVector (or 0) */
+};
+
+static uint32_t
+hash_inv_key (const void *key)
+{
+  const BtorPropInvKey *k = key;
+  return (uint32_t) k->kind + 2u * (uint32_t) k->eidx
+         + btor_bv_hash (k->bvexp) + 7u * btor_bv_hash (k->bve);
+}
+
+static int32_t
+compare_inv_key (const void *key0, const void *key1)
+{
+  const BtorPropInvKey *k0 = key0, *k1 = key1;
+  if (k0->kind != k1->kind || k0->eidx != k1->eidx) return 1;
+  if (btor_bv_get_width (k0->bvexp) != btor_bv_get_width (k1->bvexp)
+      || btor_bv_get_width (k0->bve) != btor_bv_get_width (k1->bve))
+    return 1;
+  if (btor_bv_compare (k0->bvexp, k1->bvexp)) return 1;
+  return btor_bv_compare (k0->bve, k1->bve);
+}
+
+BtorPropInvCache *
+btor_proputils_inv_cache_new (BtorMemMgr *mm)
+{
+  assert (mm);
+
+  BtorPropInvCache *res;
+
+  BTOR_CNEW (mm, res);
+  res->mm    = mm;
+  res->cache = btor_hashptr_table_new (mm, hash_inv_key, compare_inv_key);
+  return res;
+}
+
+static void
+clear_inv_cache (BtorPropInvCache *cache)
+{
+  BtorPropInvKey *key;
+  BtorBitVector *bv;
+  BtorPtrHashTableIterator it;
+
+  btor_iter_hashptr_init (&it, cache->cache);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    bv  = it.bucket->data.as_ptr;
+    key = btor_iter_hashptr_next (&it);
+    if (bv) btor_bv_free (cache->mm, bv);
+    btor_bv_free (cache->mm, key->bvexp);
+    btor_bv_free (cache->mm, key->bve);
+    BTOR_DELETE (cache->mm, key);
+  }
+  btor_hashptr_table_delete (cache->cache);
+}
+
+void
+btor_proputils_inv_cache_delete (BtorPropInvCache *cache)
+{
+  assert (cache);
+  clear_inv_cache (cache);
+  BTOR_DELETE (cache->mm, cache);
+}
+
+static BtorPropInvCache *
+get_inv_cache (Btor *btor)
+{
+  if (!btor->slv) return 0;
+  if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+    return BTOR_PROP_SOLVER (btor)->inv_cache;
+  assert (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_SLS);
+  return BTOR_SLS_SOLVER (btor)->inv_cache;
+}
+
+/* Returns true if the inverse value computation for the given tuple is
+ * cached.  In that case, 'res' is a copy of the cached value, or 0 if no
+ * inverse value exists. */
+static bool
+inv_cache_get (Btor *btor,
+               BtorNode *exp,
+               BtorBitVector *bvexp,
+               BtorBitVector *bve,
+               int32_t eidx,
+               BtorBitVector **res)
+{
+  BtorPropInvCache *cache;
+  BtorPtrHashBucket *b;
+  BtorPropInvKey key;
+
+  if (!(cache = get_inv_cache (btor))) return false;
+
+  key.kind  = exp->kind;
+  key.eidx  = eidx;
+  key.bvexp = bvexp;
+  key.bve   = bve;
+  if (!(b = btor_hashptr_table_get (cache->cache, &key))) return false;
+
+  *res = b->data.as_ptr ? btor_bv_copy (btor->mm, b->data.as_ptr) : 0;
+  if (btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+    BTOR_PROP_SOLVER (btor)->stats.inv_cache_hits += 1;
+  return true;
+}
+
+/* Cache the deterministic part 'res' of the inverse value computation for
+ * the given tuple, 'res' is 0 if no inverse value exists. */
+static void
+inv_cache_add (Btor *btor,
+               BtorNode *exp,
+               BtorBitVector *bvexp,
+               BtorBitVector *bve,
+               int32_t eidx,
+               BtorBitVector *res)
+{
+  BtorPropInvCache *cache;
+  BtorPropInvKey key, *k;
+  BtorMemMgr *mm;
+
+  if (!(cache = get_inv_cache (btor))) return;
+
+  key.kind  = exp->kind;
+  key.eidx  = eidx;
+  key.bvexp = bvexp;
+  key.bve   = bve;
+  if (btor_hashptr_table_get (cache->cache, &key)) return;
+
+  mm = cache->mm;
+  if (cache->cache->count >= BTOR_PROPUTILS_INV_CACHE_MAX_SIZE)
+  {
+    clear_inv_cache (cache);
+    cache->cache = btor_hashptr_table_new (mm, hash_inv_key, compare_inv_key);
+  }
+
+  BTOR_NEW (mm, k);
+  k->kind  = exp->kind;
+  k->eidx  = eidx;
+  k->bvexp = btor_bv_copy (mm, bvexp);
+  k->bve   = btor_bv_copy (mm, bve);
+  btor_hashptr_table_add (cache->cache, k)->data.as_ptr =
+      res ? btor_bv_copy (mm, res) : 0;
+}
+
 /* -------------------------------------------------------------------------- */
 /* INV: and                                                                   */
 /* -------------------------------------------------------------------------- */
@@ -2390,7 +2548,20 @@ inv_mul_bv (Btor *btor,
   lsbve   = btor_bv_get_bit (bve, 0);
   lsbvmul = btor_bv_get_bit (bvmul, 0);
 
-  if (btor_bv_is_zero (bve))
+  if (inv_cache_get (btor, mul, bvmul, bve, eidx, &res))
+  {
+    if (!res) goto BVMUL_CONF;
+    /* bve even -> choose one of all possible values (see below) */
+    if (!lsbve)
+    {
+      for (j = 0; j < bw; j++)
+        if (btor_bv_get_bit (bve, j)) break;
+      for (i = 0; i < j; i++)
+        btor_bv_set_bit (
+            res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
+    }
+  }
+  else if (btor_bv_is_zero (bve))
   {
     /* bve = 0 -> if bvmul = 0 choose random value, else conflict ----------- */
     if (btor_bv_is_zero (bvmul))
@@ -2401,6 +2572,7 @@ inv_mul_bv (Btor *btor,
     {
     BVMUL_CONF:
       /* CONFLICT: bve = 0 but bvmul != 0 ----------------------------------- */
+      inv_cache_add (btor, mul, bvmul, bve, eidx, 0);
       res = res_rec_conf (btor, mul, e, bvmul, bve, eidx, cons_mul_bv, "*");
 #ifndef NDEBUG
       is_inv = false;
@@ -2425,6 +2597,7 @@ inv_mul_bv (Btor *btor,
       inv = btor_bv_mod_inverse (mm, bve);
       res = btor_bv_mul (mm, inv, bvmul);
       btor_bv_free (mm, inv);
+      inv_cache_add (btor, mul, bvmul, bve, eidx, res);
     }
     /* ----------------------------------------------------------------------
      * bve even
@@ -2457,6 +2630,7 @@ inv_mul_bv (Btor *btor,
           tmp = btor_bv_slice (mm, bvmul, bw - 1, ispow2_bve);
           res = btor_bv_uext (mm, tmp, ispow2_bve);
           assert (btor_bv_get_width (res) == bw);
+          inv_cache_add (btor, mul, bvmul, bve, eidx, res);
           for (i = 0; i < (uint32_t) ispow2_bve; i++)
             btor_bv_set_bit (
                 res, bw - 1 - i, btor_rng_pick_rand (&btor->rng, 0, 1));
@@ -2494,6 +2668,7 @@ inv_mul_bv (Btor *btor,
           btor_bv_free (mm, tmp2);
           tmp = res;
           res = btor_bv_mul (mm, tmp, inv);
+          inv_cache_add (btor, mul, bvmul, bve, eidx, res);
           /* choose one of all possible values */
           for (i = 0; i < j; i++)
             btor_bv_set_bit (
@@ -2564,6 +2739,13 @@ inv_udiv_bv (Btor *btor,
 
   res = 0;
 
+  /* only conflicts are cached, (almost) all inverse values are random */
+  if (inv_cache_get (btor, udiv, bvudiv, bve, eidx, &res))
+  {
+    assert (!res);
+    goto BVUDIV_CONF;
+  }
+
   /* ------------------------------------------------------------------------
    * bve / e[1] = bvudiv
    *
@@ -2614,6 +2796,7 @@ inv_udiv_bv (Btor *btor,
       {
       BVUDIV_CONF:
         /* CONFLICT --------------------------------------------------------- */
+        inv_cache_add (btor, udiv, bvudiv, bve, eidx, 0);
         res =
             res_rec_conf (btor, udiv, e, bvudiv, bve, eidx, cons_udiv_bv, "/");
 #ifndef NDEBUG
@@ -2823,6 +3006,13 @@ inv_urem_bv (Btor *btor,
 
   res = 0;
 
+  /* only conflicts are cached, (almost) all inverse values are random */
+  if (inv_cache_get (btor, urem, bvurem, bve, eidx, &res))
+  {
+    assert (!res);
+    goto BVUREM_CONF;
+  }
+
   /* -----------------------------------------------------------------------
    * bve % e[1] = bvurem
    *
@@ -2840,6 +3030,7 @@ inv_urem_bv (Btor *btor,
       if (btor_bv_compare (bve, bvmax))
       {
       BVUREM_CONF:
+        inv_cache_add (btor, urem, bvurem, bve, eidx, 0);
         res =
             res_rec_conf (btor, urem, e, bvurem, bve, eidx, cons_urem_bv, "%");
 #ifndef NDEBUG
@@ -3485,6 +3676,104 @@ select_move (Btor *btor,
   return exp->e[eidx];
 }
 
+/* An application 'app' of a UF is either assigned 'bvapp' by updating the
+ * value of the UF at the current arguments (write move), or by propagating
+ * 'bvapp' towards one of the arguments such that 'app' reads an index where
+ * the UF already has value 'bvapp' (index move).  If there is no such index,
+ * the index move selects a random index, which resolves conflicts between
+ * applications that currently read the same index.  Returns the argument and
+ * its new assignment 'value' for an index move, and 0 for a write move. */
+static BtorNode *
+select_move_apply (Btor *btor,
+                   BtorNode *app,
+                   BtorBitVector *bvapp,
+                   BtorBitVector **value)
+{
+  assert (btor);
+  assert (app);
+  assert (btor_node_is_regular (app));
+  assert (btor_node_is_apply (app));
+  assert (btor_node_is_uf (app->e[0]));
+  assert (bvapp);
+  assert (value);
+
+  uint32_t i, n, pos;
+  BtorNode *res, *arg;
+  BtorNodePtrStack args;
+  BtorArgsIterator it;
+  const BtorPtrHashTable *model;
+  BtorPtrHashTableIterator mit;
+  BtorBitVectorTuple *t, *sel;
+  BtorBitVector *bv;
+
+  *value = 0;
+  if (!btor_rng_pick_with_prob (&btor->rng, BTOR_PROB_MAX / 2)) return 0;
+
+  BTOR_INIT_STACK (btor->mm, args);
+  btor_iter_args_init (&it, app->e[1]);
+  while (btor_iter_args_has_next (&it))
+    BTOR_PUSH_STACK (args, btor_iter_args_next (&it));
+
+  /* select an index with value 'bvapp' and an argument to change uniformly
+   * at random (reservoir sampling) */
+  sel   = 0;
+  pos   = 0;
+  n     = 0;
+  model = btor_model_get_fun (btor, app->e[0]);
+  if (model)
+  {
+    btor_iter_hashptr_init (&mit, (BtorPtrHashTable *) model);
+    while (btor_iter_hashptr_has_next (&mit))
+    {
+      bv = mit.bucket->data.as_ptr;
+      t  = btor_iter_hashptr_next (&mit);
+      if (btor_bv_compare (bv, bvapp)) continue;
+      assert (t->arity == BTOR_COUNT_STACK (args));
+      for (i = 0; i < t->arity; i++)
+      {
+        arg = BTOR_PEEK_STACK (args, i);
+        if (btor_node_is_bv_const (arg)
+            || !btor_bv_compare (t->bv[i], btor_model_get_bv (btor, arg)))
+          continue;
+        n += 1;
+        if (btor_rng_pick_rand (&btor->rng, 0, n - 1) == 0)
+        {
+          sel = t;
+          pos = i;
+        }
+      }
+    }
+  }
+
+  res = 0;
+  if (sel)
+  {
+    res    = BTOR_PEEK_STACK (args, pos);
+    *value = btor_bv_copy (btor->mm, sel->bv[pos]);
+  }
+  else
+  {
+    for (i = 0, n = 0; i < BTOR_COUNT_STACK (args); i++)
+    {
+      if (btor_node_is_bv_const (BTOR_PEEK_STACK (args, i))) continue;
+      n += 1;
+      if (btor_rng_pick_rand (&btor->rng, 0, n - 1) == 0) pos = i;
+    }
+    if (n)
+    {
+      res    = BTOR_PEEK_STACK (args, pos);
+      *value = btor_bv_new_random (
+          btor->mm,
+          &btor->rng,
+          btor_node_bv_get_width (btor, btor_node_real_addr (res)));
+    }
+  }
+  if (res && btor_opt_get (btor, BTOR_OPT_ENGINE) == BTOR_ENGINE_PROP)
+    BTOR_PROP_SOLVER (btor)->stats.props_index += 1;
+  BTOR_RELEASE_STACK (args);
+  return res;
+}
+
 uint64_t
 btor_proputils_select_move_prop (Btor *btor,
                                  BtorNode *root,
@@ -3532,6 +3821,28 @@ btor_proputils_select_move_prop (Btor *btor,
     {
       break;
     }
+    else if (btor_node_is_apply (real_cur))
+    {
+      nprops += 1;
+
+      if (btor_node_is_inverted (cur))
+      {
+        tmp   = bvcur;
+        bvcur = btor_bv_not (btor->mm, tmp);
+        btor_bv_free (btor->mm, tmp);
+      }
+
+      cur = select_move_apply (btor, real_cur, bvcur, &bvenew);
+      if (!cur)
+      {
+        *input      = real_cur;
+        *assignment = btor_bv_copy (btor->mm, bvcur);
+        break;
+      }
+
+      btor_bv_free (btor->mm, bvcur);
+      bvcur = bvenew;
+    }
     else
     {
       nprops += 1;
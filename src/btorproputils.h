@@ -25,6 +25,20 @@
 
 /*------------------------------------------------------------------------*/
 
+/* Maximum number of entries in the inverse value cache (cleared if full). */
+#define BTOR_PROPUTILS_INV_CACHE_MAX_SIZE (1u << 16)
+
+/* Cache for inverse value computations, maps (kind, eidx, target value,
+ * value of the other operand) to the deterministic part of the inverse
+ * value, or to 0 if no inverse value exists. */
+typedef struct BtorPropInvCache BtorPropInvCache;
+
+BtorPropInvCache* btor_proputils_inv_cache_new (BtorMemMgr* mm);
+
+void btor_proputils_inv_cache_delete (BtorPropInvCache* cache);
+
+/*------------------------------------------------------------------------*/
+
 uint64_t btor_proputils_select_move_prop (Btor* btor,
                                           BtorNode* root,
                                           BtorNode** input,
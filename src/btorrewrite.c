@@ -22,6 +22,7 @@
 #include "utils/btorutil.h"
 
 #include "btorrewrite.h"
+#include "btorrwtable.h"
 
 #include <assert.h>
 
@@ -61,7 +62,8 @@
  * etc.
  */
 
-/* recursive rewriting bound */
+/* recursive rewriting bound, if reached the result of the top level rewrite
+ * call is rewritten again (see rewrite_fixpoint) */
 #define BTOR_REC_RW_BOUND (1 << 12)
 
 /* iterative rewriting bounds */
@@ -78,6 +80,8 @@
     (btor)->rec_rw_calls++;                                    \
     if ((btor)->rec_rw_calls > (btor)->stats.max_rec_rw_calls) \
       (btor)->stats.max_rec_rw_calls = (btor)->rec_rw_calls;   \
+    if ((btor)->rec_rw_calls >= BTOR_REC_RW_BOUND)             \
+      (btor)->rec_rw_bound = true;                             \
   } while (0)
 
 #define BTOR_DEC_REC_RW_CALL(btor)     \
@@ -89,36 +93,142 @@
 
 // TODO: special_const_binary rewriting may return 0, hence the check if
 //       (result), may be obsolete if special_const_binary will be split
-#ifndef NDEBUG
-#define ADD_RW_RULE(rw_rule, ...)                                              \
-  if (applies_##rw_rule (btor, __VA_ARGS__))                                   \
-  {                                                                            \
-    assert (!result);                                                          \
-    result = apply_##rw_rule (btor, __VA_ARGS__);                              \
-    if (result)                                                                \
-    {                                                                          \
-      if (btor->stats.rw_rules_applied)                                        \
-      {                                                                        \
-        BtorPtrHashBucket *b =                                                 \
-            btor_hashptr_table_get (btor->stats.rw_rules_applied, #rw_rule);   \
-        if (!b)                                                                \
-          b = btor_hashptr_table_add (btor->stats.rw_rules_applied, #rw_rule); \
-        b->data.as_int += 1;                                                   \
-      }                                                                        \
-      goto DONE;                                                               \
-    }                                                                          \
+#define ADD_RW_RULE(rw_rule, ...)                                 \
+  if (!RW_CAND_HAS (rw_cand, BTOR_RW_RULE_##rw_rule))             \
+  {                                                               \
+    assert (!applies_##rw_rule (btor, __VA_ARGS__));              \
+  }                                                               \
+  else if (btor_opt_get (btor, BTOR_OPT_REWRITE_PROFILE))         \
+  {                                                               \
+    BtorRwProfState prof;                                         \
+    rw_prof_start (btor, &prof);                                  \
+    if (applies_##rw_rule (btor, __VA_ARGS__))                    \
+    {                                                             \
+      assert (!result);                                           \
+      result = apply_##rw_rule (btor, __VA_ARGS__);               \
+    }                                                             \
+    rw_prof_stop (btor, BTOR_RW_RULE_##rw_rule, &prof, result);   \
+    if (result) goto DONE;                                        \
+  }                                                               \
+  else if (applies_##rw_rule (btor, __VA_ARGS__))                 \
+  {                                                               \
+    assert (!result);                                             \
+    result = apply_##rw_rule (btor, __VA_ARGS__);                 \
+    if (result) goto DONE;                                        \
   }
-#else
-#define ADD_RW_RULE(rw_rule, ...)                 \
-  if (applies_##rw_rule (btor, __VA_ARGS__))      \
-  {                                               \
-    assert (!result);                             \
-    result = apply_##rw_rule (btor, __VA_ARGS__); \
-    if (result) goto DONE;                        \
-  }
-#endif
 //{fprintf (stderr, "apply: %s (%s)\n", #rw_rule, __FUNCTION__);
 
+/* -------------------------------------------------------------------------- */
+/* rewrite rule candidates */
+
+/* Every rewrite function computes the set of rules that may apply to its
+ * operands once (per operand order), via the tables generated from the rule
+ * specification in btormkrwtable.c.  ADD_RW_RULE skips all other rules
+ * without calling their applies_* function. */
+
+#define RW_CAND_HAS(cand, rule) \
+  (((cand).words[(rule) / 64] >> ((rule) % 64)) & 1)
+
+struct BtorRwCand
+{
+  uint64_t words[BTOR_RW_CAND_WORDS];
+};
+typedef struct BtorRwCand BtorRwCand;
+
+static const uint8_t g_rw_kind2class[BTOR_NUM_OPS_NODE] = {
+    [BTOR_BV_CONST_NODE]  = BTOR_RW_OP_CONST,
+    [BTOR_BV_SLICE_NODE]  = BTOR_RW_OP_SLICE,
+    [BTOR_BV_CONCAT_NODE] = BTOR_RW_OP_CONCAT,
+    [BTOR_BV_AND_NODE]    = BTOR_RW_OP_AND,
+    [BTOR_BV_ADD_NODE]    = BTOR_RW_OP_ADD,
+    [BTOR_BV_MUL_NODE]    = BTOR_RW_OP_MUL,
+    [BTOR_BV_UDIV_NODE]   = BTOR_RW_OP_UDIV,
+    [BTOR_BV_UREM_NODE]   = BTOR_RW_OP_UREM,
+    [BTOR_BV_SLL_NODE]    = BTOR_RW_OP_SLL,
+    [BTOR_COND_NODE]      = BTOR_RW_OP_COND,
+    [BTOR_BV_EQ_NODE]     = BTOR_RW_OP_EQ,
+    [BTOR_BV_ULT_NODE]    = BTOR_RW_OP_ULT,
+    [BTOR_LAMBDA_NODE]    = BTOR_RW_OP_LAMBDA,
+    [BTOR_UPDATE_NODE]    = BTOR_RW_OP_UPDATE,
+};
+
+static inline uint32_t
+rw_cand_feature (BtorNode *exp)
+{
+  if (!exp) return BTOR_RW_OP_OTHER;
+  return g_rw_kind2class[btor_node_real_addr (exp)->kind]
+         | ((uint32_t) btor_node_is_inverted (exp) << BTOR_RW_OP_CLASS_BITS);
+}
+
+static inline BtorRwOpRel
+rw_cand_rel (BtorNode *a, BtorNode *b)
+{
+  if (!a || !b) return BTOR_RW_REL_DIFF;
+  if (a == b) return BTOR_RW_REL_SAME;
+  if (a == btor_node_invert (b)) return BTOR_RW_REL_NEG;
+  return BTOR_RW_REL_DIFF;
+}
+
+/* Compute rule candidates for operands 'e0', 'e1' and 'e2' (may be 0).
+ * Rules compare e1 and e2 of conditionals and e0 and e1 otherwise. */
+static inline void
+rw_cand_init (BtorRwCand *cand, BtorNode *e0, BtorNode *e1, BtorNode *e2)
+{
+  uint32_t i, f0, f1, f2;
+  BtorRwOpRel rel;
+
+  f0  = rw_cand_feature (e0);
+  f1  = rw_cand_feature (e1);
+  f2  = rw_cand_feature (e2);
+  rel = e2 ? rw_cand_rel (e1, e2) : rw_cand_rel (e0, e1);
+
+  for (i = 0; i < BTOR_RW_CAND_WORDS; i++)
+    cand->words[i] = g_btor_rw_cand_op[0][f0][i] & g_btor_rw_cand_op[1][f1][i]
+                     & g_btor_rw_cand_op[2][f2][i] & g_btor_rw_cand_rel[rel][i];
+}
+
+/* -------------------------------------------------------------------------- */
+/* rewrite rule profiling */
+
+const char *const g_btor_rw_rule2str[BTOR_RW_NUM_RULES] = {
+#define BTOR_RW_RULE_STR(rule) #rule,
+    BTOR_RW_RULES (BTOR_RW_RULE_STR)
+#undef BTOR_RW_RULE_STR
+};
+
+struct BtorRwProfState
+{
+  uint32_t num_nodes;
+  double start;
+};
+typedef struct BtorRwProfState BtorRwProfState;
+
+static inline void
+rw_prof_start (Btor *btor, BtorRwProfState *prof)
+{
+  prof->num_nodes = btor->nodes_unique_table.num_elements;
+  prof->start     = btor_opt_get (btor, BTOR_OPT_REWRITE_PROFILE) > 1
+                    ? btor_util_time_stamp ()
+                    : 0;
+}
+
+static inline void
+rw_prof_stop (Btor *btor,
+              BtorRwRule rule,
+              BtorRwProfState *prof,
+              BtorNode *result)
+{
+  BtorRwRuleStats *stats;
+
+  stats = &btor->stats.rw_rules[rule];
+  stats->attempts += 1;
+  if (result) stats->applied += 1;
+  stats->nodes += (int_least64_t) btor->nodes_unique_table.num_elements
+                  - (int_least64_t) prof->num_nodes;
+  if (btor_opt_get (btor, BTOR_OPT_REWRITE_PROFILE) > 1)
+    stats->time += btor_util_time_stamp () - prof->start;
+}
+
 /* -------------------------------------------------------------------------- */
 /* rewrite cache */
 
@@ -6446,6 +6556,7 @@ static BtorNode *
 rewrite_slice_exp (Btor *btor, BtorNode *e, uint32_t upper, uint32_t lower)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e = btor_simplify_exp (btor, e);
   assert (btor_dbg_precond_slice_exp (btor, e, upper, lower));
@@ -6455,6 +6566,7 @@ rewrite_slice_exp (Btor *btor, BtorNode *e, uint32_t upper, uint32_t lower)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e, 0, 0);
     ADD_RW_RULE (full_slice, e, upper, lower);
     ADD_RW_RULE (const_slice, e, upper, lower);
     ADD_RW_RULE (slice_slice, e, upper, lower);
@@ -6494,6 +6606,7 @@ rewrite_eq_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
   BtorNodeKind kind;
 
   e0 = btor_simplify_exp (btor, e0);
@@ -6511,6 +6624,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, kind, e0, e1);
@@ -6579,6 +6693,7 @@ static BtorNode *
 rewrite_ult_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6593,6 +6708,7 @@ rewrite_ult_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_ULT_NODE, e0, e1);
@@ -6630,6 +6746,7 @@ rewrite_and_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6645,6 +6762,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, BTOR_BV_AND_NODE, e0, e1);
@@ -6712,6 +6830,7 @@ rewrite_add_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6727,6 +6846,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, BTOR_BV_ADD_NODE, e0, e1);
@@ -6785,6 +6905,7 @@ rewrite_mul_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   bool swap_ops = false;
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6800,6 +6921,7 @@ SWAP_OPERANDS:
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     if (!swap_ops)
     {
       ADD_RW_RULE (const_binary_exp, BTOR_BV_MUL_NODE, e0, e1);
@@ -6854,6 +6976,7 @@ static BtorNode *
 rewrite_udiv_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6868,6 +6991,7 @@ rewrite_udiv_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     // TODO what about non powers of 2, like divisor 3, which means that
     // some upper bits are 0 ...
 
@@ -6906,6 +7030,7 @@ static BtorNode *
 rewrite_urem_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6920,6 +7045,7 @@ rewrite_urem_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     // TODO do optimize for powers of two even AIGs do it as well !!!
 
     // TODO what about non powers of 2, like modulo 3, which means that
@@ -6958,6 +7084,7 @@ static BtorNode *
 rewrite_concat_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -6972,6 +7099,7 @@ rewrite_concat_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_CONCAT_NODE, e0, e1);
@@ -7007,6 +7135,7 @@ static BtorNode *
 rewrite_sll_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7017,6 +7146,7 @@ rewrite_sll_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_SLL_NODE, e0, e1);
@@ -7047,6 +7177,7 @@ static BtorNode *
 rewrite_srl_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7057,6 +7188,7 @@ rewrite_srl_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     ADD_RW_RULE (const_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
     ADD_RW_RULE (special_const_lhs_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
     ADD_RW_RULE (special_const_rhs_binary_exp, BTOR_BV_SRL_NODE, e0, e1);
@@ -7088,6 +7220,7 @@ static BtorNode *
 rewrite_apply_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7098,6 +7231,7 @@ rewrite_apply_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     ADD_RW_RULE (const_lambda_apply, e0, e1);
     ADD_RW_RULE (param_lambda_apply, e0, e1);
     ADD_RW_RULE (apply_apply, e0, e1);
@@ -7151,6 +7285,7 @@ static BtorNode *
 rewrite_forall_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7160,6 +7295,7 @@ rewrite_forall_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     ADD_RW_RULE (const_quantifier, e0, e1);
     ADD_RW_RULE (eq_forall, e0, e1);
     //  ADD_RW_RULE (param_free_forall, e0, e1);
@@ -7189,6 +7325,7 @@ static BtorNode *
 rewrite_exists_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7198,6 +7335,7 @@ rewrite_exists_exp (Btor *btor, BtorNode *e0, BtorNode *e1)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, 0);
     ADD_RW_RULE (const_quantifier, e0, e1);
     ADD_RW_RULE (eq_exists, e0, e1);
     //  ADD_RW_RULE (param_free_exists, e0, e1);
@@ -7227,6 +7365,7 @@ static BtorNode *
 rewrite_cond_exp (Btor *btor, BtorNode *e0, BtorNode *e1, BtorNode *e2)
 {
   BtorNode *result = 0;
+  BtorRwCand rw_cand;
 
   e0 = btor_simplify_exp (btor, e0);
   e1 = btor_simplify_exp (btor, e1);
@@ -7247,6 +7386,7 @@ rewrite_cond_exp (Btor *btor, BtorNode *e0, BtorNode *e1, BtorNode *e2)
 
   if (!result)
   {
+    rw_cand_init (&rw_cand, e0, e1, e2);
     ADD_RW_RULE (equal_branches_cond, e0, e1, e2);
     ADD_RW_RULE (const_cond, e0, e1, e2);
     ADD_RW_RULE (cond_if_dom_cond, e0, e1, e2);
@@ -7294,36 +7434,10 @@ rewrite_cond_exp (Btor *btor, BtorNode *e0, BtorNode *e1, BtorNode *e2)
 /* -------------------------------------------------------------------------- */
 /* api function */
 
-BtorNode *
-btor_rewrite_slice_exp (Btor *btor,
-                        BtorNode *exp,
-                        uint32_t upper,
-                        uint32_t lower)
-{
-  assert (btor);
-  assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 0);
-
-  BtorNode *res;
-  double start = btor_util_time_stamp ();
-  res          = rewrite_slice_exp (btor, exp, upper, lower);
-  btor->time.rewrite += btor_util_time_stamp () - start;
-  return res;
-}
-
-BtorNode *
-btor_rewrite_binary_exp (Btor *btor,
-                         BtorNodeKind kind,
-                         BtorNode *e0,
-                         BtorNode *e1)
+static BtorNode *
+rewrite_binary_exp (Btor *btor, BtorNodeKind kind, BtorNode *e0, BtorNode *e1)
 {
-  assert (btor);
-  assert (kind);
-  assert (e0);
-  assert (e1);
-  assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 0);
-
   BtorNode *result;
-  double start = btor_util_time_stamp ();
 
   switch (kind)
   {
@@ -7358,6 +7472,184 @@ btor_rewrite_binary_exp (Btor *btor,
       assert (kind == BTOR_LAMBDA_NODE);
       result = rewrite_lambda_exp (btor, e0, e1);
   }
+  return result;
+}
+
+/* -------------------------------------------------------------------------- */
+/* fixpoint rewriting                                                         */
+/* -------------------------------------------------------------------------- */
+
+/* Rules that rewrite recursively are disabled once BTOR_REC_RW_BOUND is
+ * reached, which protects the C stack but may leave nodes created below the
+ * bound not fully rewritten.  In that case, the top level rewrite call
+ * rewrites the cone of its result again, bottom-up with an explicit stack,
+ * until no more rewrites are possible or the bound is not reached anymore.
+ * Only nodes created during the top level call (id >= 'min_id') and bit-vector
+ * operators are rewritten, all other nodes are considered fully rewritten. */
+
+static bool
+is_fixpoint_rw_node (BtorNode *exp, int32_t min_id)
+{
+  exp = btor_node_real_addr (exp);
+  return exp->id >= min_id && !exp->parameterized
+         && (btor_node_is_bv_slice (exp) || btor_node_is_bv_and (exp)
+             || btor_node_is_bv_eq (exp) || btor_node_is_bv_add (exp)
+             || btor_node_is_bv_mul (exp) || btor_node_is_bv_ult (exp)
+             || btor_node_is_bv_sll (exp) || btor_node_is_bv_srl (exp)
+             || btor_node_is_bv_udiv (exp) || btor_node_is_bv_urem (exp)
+             || btor_node_is_bv_concat (exp) || btor_node_is_bv_cond (exp));
+}
+
+static BtorNode *
+rewrite_cone (Btor *btor, BtorNode *exp, int32_t min_id)
+{
+  uint32_t i;
+  BtorNode *cur, *real_cur, *result, *e[3];
+  BtorNodePtrStack visit;
+  BtorIntHashTable *cache;
+  BtorHashTableData *d;
+  BtorMemMgr *mm;
+
+  mm    = btor->mm;
+  cache = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, exp);
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur      = BTOR_POP_STACK (visit);
+    real_cur = btor_node_real_addr (cur);
+    d        = btor_hashint_map_get (cache, real_cur->id);
+
+    if (!d)
+    {
+      btor_hashint_map_add (cache, real_cur->id);
+      BTOR_PUSH_STACK (visit, real_cur);
+      for (i = 0; i < real_cur->arity; i++)
+        if (is_fixpoint_rw_node (real_cur->e[i], min_id))
+          BTOR_PUSH_STACK (visit, real_cur->e[i]);
+    }
+    else if (!d->as_ptr)
+    {
+      for (i = 0; i < real_cur->arity; i++)
+      {
+        e[i] = real_cur->e[i];
+        if (is_fixpoint_rw_node (e[i], min_id))
+        {
+          d = btor_hashint_map_get (cache, btor_node_real_addr (e[i])->id);
+          assert (d);
+          assert (d->as_ptr);
+          e[i] = btor_node_cond_invert (e[i], d->as_ptr);
+        }
+      }
+      if (real_cur->kind == BTOR_BV_SLICE_NODE)
+        result = rewrite_slice_exp (btor,
+                                    e[0],
+                                    btor_node_bv_slice_get_upper (real_cur),
+                                    btor_node_bv_slice_get_lower (real_cur));
+      else if (real_cur->kind == BTOR_COND_NODE)
+        result = rewrite_cond_exp (btor, e[0], e[1], e[2]);
+      else
+        result = rewrite_binary_exp (btor, real_cur->kind, e[0], e[1]);
+      d         = btor_hashint_map_get (cache, real_cur->id);
+      d->as_ptr = result;
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  d = btor_hashint_map_get (cache, btor_node_real_addr (exp)->id);
+  assert (d);
+  result = btor_node_copy (btor, btor_node_cond_invert (exp, d->as_ptr));
+
+  for (i = 0; i < cache->size; i++)
+  {
+    if (!cache->data[i].as_ptr) continue;
+    btor_node_release (btor, cache->data[i].as_ptr);
+  }
+  btor_hashint_map_delete (cache);
+  return result;
+}
+
+static BtorNode *
+rewrite_fixpoint (Btor *btor, BtorNode *exp, int32_t min_id)
+{
+  BtorNode *result;
+
+  while (btor->rec_rw_bound && is_fixpoint_rw_node (exp, min_id))
+  {
+    assert (btor->rec_rw_calls == 0);
+    btor->rec_rw_bound = false;
+    btor->stats.rw_fixpoint_passes += 1;
+    result = rewrite_cone (btor, exp, min_id);
+    btor_node_release (btor, exp);
+    if (result == exp) return result;
+    exp = result;
+  }
+  return exp;
+}
+
+/* Start a top level rewrite call, returns false for nested calls. */
+static bool
+rw_driver_enter (Btor *btor, int32_t *min_id)
+{
+  if (btor->rw_driver) return false;
+  btor->rw_driver    = true;
+  btor->rec_rw_bound = false;
+  *min_id            = BTOR_COUNT_STACK (btor->nodes_id_table);
+  return true;
+}
+
+static BtorNode *
+rw_driver_leave (Btor *btor, BtorNode *exp, int32_t min_id)
+{
+  assert (btor->rw_driver);
+  exp                = rewrite_fixpoint (btor, exp, min_id);
+  btor->rw_driver    = false;
+  btor->rec_rw_bound = false;
+  return exp;
+}
+
+/* -------------------------------------------------------------------------- */
+
+BtorNode *
+btor_rewrite_slice_exp (Btor *btor,
+                        BtorNode *exp,
+                        uint32_t upper,
+                        uint32_t lower)
+{
+  assert (btor);
+  assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 0);
+
+  bool top;
+  int32_t min_id;
+  BtorNode *res;
+  double start = btor_util_time_stamp ();
+  top          = rw_driver_enter (btor, &min_id);
+  res          = rewrite_slice_exp (btor, exp, upper, lower);
+  if (top) res = rw_driver_leave (btor, res, min_id);
+  btor->time.rewrite += btor_util_time_stamp () - start;
+  return res;
+}
+
+BtorNode *
+btor_rewrite_binary_exp (Btor *btor,
+                         BtorNodeKind kind,
+                         BtorNode *e0,
+                         BtorNode *e1)
+{
+  assert (btor);
+  assert (kind);
+  assert (e0);
+  assert (e1);
+  assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 0);
+
+  bool top;
+  int32_t min_id;
+  BtorNode *result;
+  double start = btor_util_time_stamp ();
+
+  top    = rw_driver_enter (btor, &min_id);
+  result = rewrite_binary_exp (btor, kind, e0, e1);
+  if (top) result = rw_driver_leave (btor, result, min_id);
 
   btor->time.rewrite += btor_util_time_stamp () - start;
   return result;
@@ -7376,9 +7668,103 @@ btor_rewrite_ternary_exp (
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 0);
   (void) kind;
 
+  bool top;
+  int32_t min_id;
   BtorNode *res;
   double start = btor_util_time_stamp ();
+  top          = rw_driver_enter (btor, &min_id);
   res          = rewrite_cond_exp (btor, e0, e1, e2);
+  if (top) res = rw_driver_leave (btor, res, min_id);
   btor->time.rewrite += btor_util_time_stamp () - start;
   return res;
 }
+
+/* -------------------------------------------------------------------------- */
+
+void
+btor_rewrite_print_profile (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  bool with_time;
+  BtorRwRuleStats *stats;
+
+  with_time = btor_opt_get (btor, BTOR_OPT_REWRITE_PROFILE) > 1;
+
+  BTOR_MSG (btor->msg, 1, "rewrite rule profile:");
+  if (with_time)
+    BTOR_MSG (btor->msg,
+              1,
+              "  %10s %10s %10s %10s %s",
+              "attempts",
+              "applied",
+              "nodes",
+              "seconds",
+              "rule");
+  else
+    BTOR_MSG (btor->msg,
+              1,
+              "  %10s %10s %10s  %s",
+              "attempts",
+              "applied",
+              "nodes",
+              "rule");
+  for (i = 0; i < BTOR_RW_NUM_RULES; i++)
+  {
+    stats = &btor->stats.rw_rules[i];
+    if (!stats->attempts) continue;
+    if (with_time)
+      BTOR_MSG (btor->msg,
+                1,
+                "  %10llu %10llu %+10lld %10.2f %s",
+                (unsigned long long) stats->attempts,
+                (unsigned long long) stats->applied,
+                (long long) stats->nodes,
+                stats->time,
+                g_btor_rw_rule2str[i]);
+    else
+      BTOR_MSG (btor->msg,
+                1,
+                "  %10llu %10llu %+10lld  %s",
+                (unsigned long long) stats->attempts,
+                (unsigned long long) stats->applied,
+                (long long) stats->nodes,
+                g_btor_rw_rule2str[i]);
+  }
+}
+
+void
+btor_rewrite_dump_profile_json (Btor *btor, FILE *file)
+{
+  assert (btor);
+  assert (file);
+
+  uint32_t i;
+  bool first;
+  BtorRwRuleStats *stats;
+
+  fprintf (file, "{\n");
+  fprintf (file,
+           "  \"rewrite_level\": %u,\n",
+           btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL));
+  fprintf (file, "  \"time_rewrite\": %.6f,\n", btor->time.rewrite);
+  fprintf (file, "  \"rules\": [");
+  for (i = 0, first = true; i < BTOR_RW_NUM_RULES; i++)
+  {
+    stats = &btor->stats.rw_rules[i];
+    if (!stats->attempts) continue;
+    fprintf (file,
+             "%s\n    {\"rule\": \"%s\", \"attempts\": %llu, "
+             "\"applied\": %llu, \"nodes\": %lld, \"time\": %.6f}",
+             first ? "" : ",",
+             g_btor_rw_rule2str[i],
+             (unsigned long long) stats->attempts,
+             (unsigned long long) stats->applied,
+             (long long) stats->nodes,
+             stats->time);
+    first = false;
+  }
+  fprintf (file, "%s]\n}\n", first ? "" : "\n  ");
+  fflush (file);
+}
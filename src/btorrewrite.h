@@ -13,6 +13,25 @@
 #define BTORREWRITE_H_INCLUDED
 
 #include "btornode.h"
+#include "btorrwrules.h"
+
+#include <stdio.h>
+
+/*------------------------------------------------------------------------*/
+
+/* Per rule statistics, only collected if BTOR_OPT_REWRITE_PROFILE is enabled.
+ * Note that 'nodes' and 'time' are inclusive, i.e., they also account for
+ * rules applied recursively while applying a rule. */
+struct BtorRwRuleStats
+{
+  uint_least64_t attempts; /* number of applicability checks */
+  uint_least64_t applied;  /* number of successful applications */
+  int_least64_t nodes;     /* delta of the number of (unique) nodes */
+  double time;             /* time spent (BTOR_OPT_REWRITE_PROFILE > 1 only) */
+};
+typedef struct BtorRwRuleStats BtorRwRuleStats;
+
+extern const char *const g_btor_rw_rule2str[BTOR_RW_NUM_RULES];
 
 /*------------------------------------------------------------------------*/
 
@@ -34,4 +53,11 @@ bool btor_rewrite_linear_term (Btor *btor,
                                BtorBitVector **fp,
                                BtorNode **lp,
                                BtorNode **rp);
+
+/* Print rewrite rule statistics collected with BTOR_OPT_REWRITE_PROFILE. */
+void btor_rewrite_print_profile (Btor *btor);
+
+/* Dump rewrite rule statistics collected with BTOR_OPT_REWRITE_PROFILE in
+ * JSON format to given file. */
+void btor_rewrite_dump_profile_json (Btor *btor, FILE *file);
 #endif
@@ -0,0 +1,191 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORRWRULES_H_INCLUDED
+#define BTORRWRULES_H_INCLUDED
+
+/* Note: This header is also included by the rewrite rule table generator
+ *       (btormkrwtable.c), do not add any dependencies to other headers. */
+
+/*------------------------------------------------------------------------*/
+
+/* All rewrite rules added via ADD_RW_RULE in btorrewrite.c. */
+#define BTOR_RW_RULES(X)                                                       \
+  X (full_slice)                                                               \
+  X (const_slice)                                                              \
+  X (slice_slice)                                                              \
+  X (concat_lower_slice)                                                       \
+  X (concat_upper_slice)                                                       \
+  X (concat_rec_upper_slice)                                                   \
+  X (concat_rec_lower_slice)                                                   \
+  X (concat_rec_slice)                                                         \
+  X (and_slice)                                                                \
+  X (bcond_slice)                                                              \
+  X (zero_lower_slice)                                                         \
+  X (const_binary_exp)                                                         \
+  X (true_eq)                                                                  \
+  X (false_eq)                                                                 \
+  X (bcond_eq)                                                                 \
+  X (special_const_lhs_binary_exp)                                             \
+  X (special_const_rhs_binary_exp)                                             \
+  X (add_left_eq)                                                              \
+  X (add_right_eq)                                                             \
+  X (add_add_1_eq)                                                             \
+  X (add_add_2_eq)                                                             \
+  X (add_add_3_eq)                                                             \
+  X (add_add_4_eq)                                                             \
+  X (sub_eq)                                                                   \
+  X (bcond_uneq_if_eq)                                                         \
+  X (bcond_uneq_else_eq)                                                       \
+  X (bcond_if_eq)                                                              \
+  X (bcond_else_eq)                                                            \
+  X (distrib_add_mul_eq)                                                       \
+  X (concat_eq)                                                                \
+  X (false_ult)                                                                \
+  X (bool_ult)                                                                 \
+  X (concat_upper_ult)                                                         \
+  X (concat_lower_ult)                                                         \
+  X (bcond_ult)                                                                \
+  X (idem1_and)                                                                \
+  X (contr1_and)                                                               \
+  X (contr2_and)                                                               \
+  X (idem2_and)                                                                \
+  X (comm_and)                                                                 \
+  X (bool_xnor_and)                                                            \
+  X (resol1_and)                                                               \
+  X (resol2_and)                                                               \
+  X (ult_false_and)                                                            \
+  X (ult_and)                                                                  \
+  X (contr_rec_and)                                                            \
+  X (subsum1_and)                                                              \
+  X (subst1_and)                                                               \
+  X (subst2_and)                                                               \
+  X (subsum2_and)                                                              \
+  X (subst3_and)                                                               \
+  X (subst4_and)                                                               \
+  X (contr3_and)                                                               \
+  X (idem3_and)                                                                \
+  X (const1_and)                                                               \
+  X (const2_and)                                                               \
+  X (concat_and)                                                               \
+  X (bool_add)                                                                 \
+  X (mult_add)                                                                 \
+  X (not_add)                                                                  \
+  X (bcond_add)                                                                \
+  X (urem_add)                                                                 \
+  X (neg_add)                                                                  \
+  X (zero_add)                                                                 \
+  X (const_lhs_add)                                                            \
+  X (const_rhs_add)                                                            \
+  X (const_neg_lhs_add)                                                        \
+  X (const_neg_rhs_add)                                                        \
+  X (push_ite_add)                                                             \
+  X (sll_add)                                                                  \
+  X (bool_mul)                                                                 \
+  X (bcond_mul)                                                                \
+  X (const_lhs_mul)                                                            \
+  X (const_rhs_mul)                                                            \
+  X (const_mul)                                                                \
+  X (push_ite_mul)                                                             \
+  X (sll_mul)                                                                  \
+  X (neg_mul)                                                                  \
+  X (bool_udiv)                                                                \
+  X (power2_udiv)                                                              \
+  X (one_udiv)                                                                 \
+  X (bcond_udiv)                                                               \
+  X (bool_urem)                                                                \
+  X (zero_urem)                                                                \
+  X (const_concat)                                                             \
+  X (slice_concat)                                                             \
+  X (and_lhs_concat)                                                           \
+  X (and_rhs_concat)                                                           \
+  X (const_sll)                                                                \
+  X (const_srl)                                                                \
+  X (zero_srl)                                                                 \
+  X (const_lambda_apply)                                                       \
+  X (param_lambda_apply)                                                       \
+  X (apply_apply)                                                              \
+  X (prop_apply_lambda)                                                        \
+  X (prop_apply_update)                                                        \
+  X (lambda_lambda)                                                            \
+  X (const_quantifier)                                                         \
+  X (eq_forall)                                                                \
+  X (param_free_forall)                                                        \
+  X (eq_exists)                                                                \
+  X (param_free_exists)                                                        \
+  X (equal_branches_cond)                                                      \
+  X (const_cond)                                                               \
+  X (cond_if_dom_cond)                                                         \
+  X (cond_if_merge_if_cond)                                                    \
+  X (cond_if_merge_else_cond)                                                  \
+  X (cond_else_dom_cond)                                                       \
+  X (cond_else_merge_if_cond)                                                  \
+  X (cond_else_merge_else_cond)                                                \
+  X (bool_cond)                                                                \
+  X (add_if_cond)                                                              \
+  X (add_else_cond)                                                            \
+  X (concat_cond)                                                              \
+  X (op_lhs_cond)                                                              \
+  X (op_rhs_cond)                                                              \
+  X (comm_op_1_cond)                                                           \
+  X (comm_op_2_cond)
+
+enum BtorRwRule
+{
+#define BTOR_RW_RULE_ENUM(rule) BTOR_RW_RULE_##rule,
+  BTOR_RW_RULES (BTOR_RW_RULE_ENUM)
+#undef BTOR_RW_RULE_ENUM
+  BTOR_RW_NUM_RULES
+};
+typedef enum BtorRwRule BtorRwRule;
+
+/*------------------------------------------------------------------------*/
+
+/* Operand classes for pre-filtering rewrite rules. The feature of an operand
+ * is its class (the kind of its real address) plus its polarity, i.e.,
+ *
+ *   feature = class | (inverted << BTOR_RW_OP_CLASS_BITS)
+ *
+ * Node kinds without a dedicated class map to BTOR_RW_OP_OTHER. */
+enum BtorRwOpClass
+{
+  BTOR_RW_OP_OTHER = 0,
+  BTOR_RW_OP_CONST,
+  BTOR_RW_OP_SLICE,
+  BTOR_RW_OP_CONCAT,
+  BTOR_RW_OP_AND,
+  BTOR_RW_OP_ADD,
+  BTOR_RW_OP_MUL,
+  BTOR_RW_OP_UDIV,
+  BTOR_RW_OP_UREM,
+  BTOR_RW_OP_SLL,
+  BTOR_RW_OP_COND,
+  BTOR_RW_OP_EQ,
+  BTOR_RW_OP_ULT,
+  BTOR_RW_OP_LAMBDA,
+  BTOR_RW_OP_UPDATE,
+  BTOR_RW_NUM_OP_CLASSES
+};
+typedef enum BtorRwOpClass BtorRwOpClass;
+
+#define BTOR_RW_OP_CLASS_BITS 4
+#define BTOR_RW_NUM_OP_FEATURES (1u << (BTOR_RW_OP_CLASS_BITS + 1))
+
+/* Relation between the two operands that are compared by rules (e0 and e1
+ * for binary nodes, e1 and e2 for conditionals). */
+enum BtorRwOpRel
+{
+  BTOR_RW_REL_DIFF = 0, /* different real addresses */
+  BTOR_RW_REL_SAME,     /* a == b */
+  BTOR_RW_REL_NEG,      /* a == ~b */
+  BTOR_RW_NUM_OP_RELS
+};
+typedef enum BtorRwOpRel BtorRwOpRel;
+
+/* Number of 64-bit words of a rule candidate set. */
+#define BTOR_RW_CAND_WORDS ((BTOR_RW_NUM_RULES + 63) / 64)
+
+#endif
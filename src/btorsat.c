@@ -115,6 +115,12 @@ melt (BtorSATMgr *smgr, int32_t lit)
   // TODO: else case warning?
 }
 
+static inline void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  if (smgr->api.phase) smgr->api.phase (smgr, lit);
+}
+
 static inline int32_t
 repr (BtorSATMgr *smgr, int32_t lit)
 {
@@ -363,6 +369,26 @@ btor_sat_init (BtorSATMgr *smgr)
   btor_sat_set_output (smgr, stdout);
 }
 
+void
+btor_sat_reinit (BtorSATMgr *smgr)
+{
+  assert (smgr);
+  assert (smgr->initialized);
+  assert (!smgr->have_restore);
+
+  double sat_time;
+  FILE *output;
+
+  sat_time = smgr->sat_time;
+  output   = smgr->output;
+  btor_sat_reset (smgr);
+  smgr->maxvar  = 0;
+  smgr->clauses = 0;
+  btor_sat_init (smgr);
+  btor_sat_set_output (smgr, output);
+  smgr->sat_time = sat_time;
+}
+
 void
 btor_sat_print_stats (BtorSATMgr *smgr)
 {
@@ -457,6 +483,15 @@ btor_sat_fixed (BtorSATMgr *smgr, int32_t lit)
   return res;
 }
 
+void
+btor_sat_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  assert (smgr != NULL);
+  assert (smgr->initialized);
+  assert (abs (lit) <= smgr->maxvar);
+  phase (smgr, lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 void
@@ -700,6 +735,13 @@ dimacs_printer_melt (BtorSATMgr *smgr, int32_t lit)
   melt (wrapped_smgr, lit);
 }
 
+static void
+dimacs_printer_phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorCnfPrinter *printer = (BtorCnfPrinter *) smgr->solver;
+  phase (printer->smgr, lit);
+}
+
 /*------------------------------------------------------------------------*/
 
 /* The DIMACS printer is a SAT manager that wraps the currently configured SAT
@@ -731,6 +773,7 @@ enable_dimacs_printer (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = dimacs_printer_inc_max_var;
   smgr->api.init             = dimacs_printer_init;
   smgr->api.melt             = dimacs_printer_melt;
+  smgr->api.phase            = dimacs_printer_phase;
   smgr->api.repr             = dimacs_printer_repr;
   smgr->api.reset            = dimacs_printer_reset;
   smgr->api.sat              = dimacs_printer_sat;
@@ -66,6 +66,7 @@ struct BtorSATMgr
     int32_t (*inc_max_var) (BtorSATMgr *);
     void *(*init) (BtorSATMgr *); /* required */
     void (*melt) (BtorSATMgr *, int32_t);
+    void (*phase) (BtorSATMgr *, int32_t);
     int32_t (*repr) (BtorSATMgr *, int32_t);
     void (*reset) (BtorSATMgr *);           /* required */
     int32_t (*sat) (BtorSATMgr *, int32_t); /* required */
@@ -127,6 +128,10 @@ void btor_sat_enable_solver (BtorSATMgr *smgr);
 /* Inits the SAT solver. */
 void btor_sat_init (BtorSATMgr *smgr);
 
+/* Replaces the SAT solver with a fresh instance of the same solver.
+ * All clauses and CNF indices are discarded. */
+void btor_sat_reinit (BtorSATMgr *smgr);
+
 /* Returns if the SAT solver has already been initialized */
 bool btor_sat_is_initialized (BtorSATMgr *smgr);
 
@@ -151,6 +156,12 @@ void btor_sat_assume (BtorSATMgr *smgr, int32_t lit);
  */
 int32_t btor_sat_failed (BtorSATMgr *smgr, int32_t lit);
 
+/* Sets the default phase of the variable of a literal such that the literal
+ * is true if the variable is picked as decision.
+ * Ignored if the SAT solver does not support this.
+ */
+void btor_sat_phase (BtorSATMgr *smgr, int32_t lit);
+
 /* Solves the SAT instance.
  * limit < 0 -> no limit.
  */
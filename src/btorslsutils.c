@@ -354,6 +354,118 @@ btor_slsutils_compute_score_node (Btor *btor,
   return res;
 }
 
+/* Same as hamming_distance, min_flip and min_flip_inv, but on assignments of
+ * at most 64 bits, given as (zero-extended) 64-bit words. */
+
+static uint32_t
+hamming_distance_uint64 (uint64_t a, uint64_t b)
+{
+  uint32_t res;
+  uint64_t x;
+
+  for (res = 0, x = a ^ b; x; res++) x &= x - 1;
+  return res;
+}
+
+static uint32_t
+min_flip_uint64 (uint64_t a, uint64_t b, uint32_t bw)
+{
+  uint32_t i, j, res;
+
+  if (!b) return hamming_distance_uint64 (a, b);
+  for (res = 0, i = 0, j = bw - 1; i < bw; i++, j--)
+  {
+    if (!((a >> j) & 1)) continue;
+    res += 1;
+    a &= ~((uint64_t) 1 << j);
+    if (a < b) break;
+  }
+  return res;
+}
+
+static uint32_t
+min_flip_inv_uint64 (uint64_t a, uint64_t b, uint32_t bw)
+{
+  uint32_t i, j, res;
+
+  for (res = 0, i = 0, j = bw - 1; i < bw; i++, j--)
+  {
+    if ((a >> j) & 1) continue;
+    res += 1;
+    a |= (uint64_t) 1 << j;
+    if (a >= b) break;
+  }
+  return res;
+}
+
+double
+btor_slsutils_compute_score_node_uint64 (Btor *btor,
+                                         BtorNode *exp,
+                                         uint64_t a,
+                                         uint64_t a0,
+                                         uint64_t a1,
+                                         double s0,
+                                         double s1)
+{
+  assert (btor);
+  assert (exp);
+  assert (btor_node_bv_get_width (btor, exp) == 1);
+
+  double res;
+  uint32_t bw;
+  BtorNode *real_exp;
+
+  real_exp = btor_node_real_addr (exp);
+
+  if (btor_node_is_bv_and (real_exp))
+  {
+    if (btor_node_is_inverted (exp))
+    {
+      /* OR */
+      res = s0 > s1 ? s0 : s1;
+    }
+    else
+    {
+      /* AND */
+      res = (s0 + s1) / 2.0;
+      if (res == 1.0 && (s0 < 1.0 || s1 < 1.0)) res = s0 < s1 ? s0 : s1;
+    }
+  }
+  else if (btor_node_is_bv_eq (real_exp))
+  {
+    bw = btor_node_bv_get_width (btor, real_exp->e[0]);
+    assert (bw <= 64);
+    if (btor_node_is_inverted (exp))
+      res = a0 == a1 ? 0.0 : 1.0;
+    else
+      res = a0 == a1 ? 1.0
+                     : BTOR_SLS_SCORE_CFACT
+                           * (1.0 - hamming_distance_uint64 (a0, a1)
+                                        / (double) bw);
+  }
+  else if (btor_node_is_bv_ult (real_exp))
+  {
+    bw = btor_node_bv_get_width (btor, real_exp->e[0]);
+    assert (bw <= 64);
+    if (btor_node_is_inverted (exp))
+      res = a0 >= a1 ? 1.0
+                     : BTOR_SLS_SCORE_CFACT
+                           * (1.0 - min_flip_inv_uint64 (a0, a1, bw)
+                                        / (double) bw);
+    else
+      res = a0 < a1 ? 1.0
+                    : BTOR_SLS_SCORE_CFACT
+                          * (1.0 - min_flip_uint64 (a0, a1, bw) / (double) bw);
+  }
+  else
+  {
+    res = a & 1;
+  }
+
+  assert (res >= 0.0 && res <= 1.0);
+  return res;
+}
+
 static double
 recursively_compute_sls_score_node (Btor *btor,
                                     BtorIntHashTable *bv_model,
@@ -409,7 +521,9 @@ recursively_compute_sls_score_node (Btor *btor,
       assert (d->as_int == 0);
       d->as_int = 1;
 
-      if (btor_node_bv_get_width (btor, real_cur) != 1) continue;
+      if (btor_node_is_fun (real_cur) || btor_node_is_args (real_cur)
+          || btor_node_bv_get_width (btor, real_cur) != 1)
+        continue;
 
       res = btor_slsutils_compute_score_node (
           btor, bv_model, fun_model, score, cur);
@@ -485,7 +599,9 @@ btor_slsutils_compute_sls_scores (Btor *btor,
     {
       assert (d->as_int == 0);
       d->as_int = 1;
-      if (btor_node_bv_get_width (btor, real_cur) != 1) continue;
+      if (btor_node_is_fun (real_cur) || btor_node_is_args (real_cur)
+          || btor_node_bv_get_width (btor, real_cur) != 1)
+        continue;
       (void) recursively_compute_sls_score_node (
           btor, bv_model, fun_model, score, cur);
       (void) recursively_compute_sls_score_node (
@@ -18,6 +18,18 @@ double btor_slsutils_compute_score_node (Btor *btor,
                                          BtorIntHashTable *score,
                                          BtorNode *exp);
 
+/* Compute the score of 'exp' as btor_slsutils_compute_score_node, but from
+ * given assignments of at most 64 bits: 'a' is the assignment of 'exp', 'a0'
+ * and 'a1' are the assignments of its children (eq, ult), 's0' and 's1' the
+ * scores of its children (and), negated if 'exp' is negated. */
+double btor_slsutils_compute_score_node_uint64 (Btor *btor,
+                                                BtorNode *exp,
+                                                uint64_t a,
+                                                uint64_t a0,
+                                                uint64_t a1,
+                                                double s0,
+                                                double s1);
+
 void btor_slsutils_compute_sls_scores (Btor *btor,
                                        BtorIntHashTable *bv_model,
                                        BtorIntHashTable *fun_model,
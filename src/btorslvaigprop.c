@@ -264,6 +264,7 @@ sat_aigprop_solver (BtorAIGPropSolver *slv)
 
   if ((sat_result = aigprop_sat (slv->aprop, roots)) == BTOR_RESULT_UNSAT)
     goto UNSAT;
+  if (sat_result == BTOR_RESULT_UNKNOWN) goto DONE;
   generate_model_from_aig_model (btor);
   assert (sat_result == BTOR_RESULT_SAT);
   slv->stats.moves                  = slv->aprop->stats.moves;
@@ -31,6 +31,111 @@
 
 /*------------------------------------------------------------------------*/
 
+static void
+delete_dual_prop_clone (BtorFunSolver *slv)
+{
+  assert (slv);
+
+  Btor *btor, *clone;
+  BtorPtrHashTableIterator it;
+
+  btor  = slv->btor;
+  clone = slv->dp_clone;
+  if (!clone) return;
+
+  btor_iter_hashptr_init (&it, slv->dp_assumed);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    btor_node_release (clone, it.bucket->data.as_ptr);
+    btor_node_release (clone, btor_iter_hashptr_next (&it));
+  }
+  btor_hashptr_table_delete (slv->dp_assumed);
+
+  btor_iter_hashptr_init (&it, slv->dp_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_node_release (btor, btor_iter_hashptr_next (&it));
+  btor_hashptr_table_delete (slv->dp_constraints);
+
+  if (slv->dp_root) btor_node_release (clone, slv->dp_root);
+  btor_nodemap_delete (slv->dp_exp_map);
+  btor_delete (clone);
+
+  slv->dp_clone       = 0;
+  slv->dp_exp_map     = 0;
+  slv->dp_root        = 0;
+  slv->dp_constraints = 0;
+  slv->dp_assumed     = 0;
+}
+
+static BtorNode *
+get_dual_prop_clone_node (Btor *clone, BtorNode *exp)
+{
+  BtorNode *res;
+
+  /* cloning preserves node ids */
+  res = btor_node_get_by_id (clone, btor_node_get_id (exp));
+  assert (res);
+  return res;
+}
+
+/* Clone the dual prop clone of 'slv' into 'res', the solver of 'clone'.
+ * Nodes of the dual prop clone are mapped via their id and the cloned maps
+ * and tables do not add references, as cloning copies reference counts. */
+static void
+clone_dual_prop_clone (Btor *clone,
+                       BtorFunSolver *slv,
+                       BtorFunSolver *res,
+                       BtorNodeMap *exp_map)
+{
+  assert (slv->dp_clone);
+
+  Btor *cdp;
+  BtorNode *key, *data;
+  BtorPtrHashTableIterator it;
+  BtorPtrHashBucket *b;
+
+  res->dp_clone       = 0;
+  res->dp_exp_map     = 0;
+  res->dp_root        = 0;
+  res->dp_constraints = 0;
+  res->dp_assumed     = 0;
+  if (!btor_sat_mgr_has_clone_support (btor_get_sat_mgr (slv->dp_clone)))
+    return;
+
+  cdp           = btor_clone_btor (slv->dp_clone);
+  res->dp_clone = cdp;
+
+  res->dp_exp_map = btor_nodemap_new (clone);
+  btor_iter_hashptr_init (&it, slv->dp_exp_map->table);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    data = it.bucket->data.as_ptr;
+    key  = btor_nodemap_mapped (exp_map, btor_iter_hashptr_next (&it));
+    assert (key);
+    b              = btor_hashptr_table_add (res->dp_exp_map->table, key);
+    b->data.as_ptr = get_dual_prop_clone_node (cdp, data);
+  }
+
+  if (slv->dp_root)
+    res->dp_root = get_dual_prop_clone_node (cdp, slv->dp_root);
+
+  res->dp_constraints = btor_hashptr_table_clone (
+      clone->mm, slv->dp_constraints, btor_clone_key_as_node, 0, exp_map, 0);
+
+  res->dp_assumed = btor_hashptr_table_new (
+      clone->mm,
+      (BtorHashPtr) btor_node_hash_by_id,
+      (BtorCmpPtr) btor_node_compare_by_id);
+  btor_iter_hashptr_init (&it, slv->dp_assumed);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    data = it.bucket->data.as_ptr;
+    key  = get_dual_prop_clone_node (cdp, btor_iter_hashptr_next (&it));
+    b    = btor_hashptr_table_add (res->dp_assumed, key);
+    b->data.as_ptr = get_dual_prop_clone_node (cdp, data);
+  }
+}
+
 static BtorFunSolver *
 clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
 {
@@ -54,6 +159,12 @@ clone_fun_solver (Btor *clone, BtorFunSolver *slv, BtorNodeMap *exp_map)
 
   btor_clone_node_ptr_stack (
       clone->mm, &slv->cur_lemmas, &res->cur_lemmas, exp_map, false);
+  btor_clone_node_ptr_stack (
+      clone->mm, &slv->init_apps, &res->init_apps, exp_map, false);
+  res->init_apps_cache =
+      btor_hashint_table_clone (clone->mm, slv->init_apps_cache);
+
+  if (slv->dp_clone) clone_dual_prop_clone (clone, slv, res, exp_map);
 
   if (slv->score)
   {
@@ -118,6 +229,13 @@ delete_fun_solver (BtorFunSolver *slv)
     btor_node_release (btor, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (slv->lemmas);
 
+  delete_dual_prop_clone (slv);
+
+  while (!BTOR_EMPTY_STACK (slv->init_apps))
+    btor_node_release (btor, BTOR_POP_STACK (slv->init_apps));
+  BTOR_RELEASE_STACK (slv->init_apps);
+  btor_hashint_table_delete (slv->init_apps_cache);
+
   if (slv->score)
   {
     btor_iter_hashptr_init (&it, slv->score);
@@ -242,6 +360,47 @@ configure_sat_mgr (Btor *btor)
       smgr->name);
 }
 
+/* Seed the phases of the SAT solver with the assignment of the bit-vector
+ * variables in 'phases', e.g., the best assignment found by the prop or sls
+ * engine with --fun-preprop or --fun-presls. */
+static void
+seed_phases (Btor *btor, BtorIntHashTable *phases)
+{
+  assert (btor);
+  assert (phases);
+
+  int32_t id, lit;
+  uint32_t i, width, nseeded;
+  BtorNode *var;
+  BtorBitVector *bv;
+  BtorAIG *aig;
+  BtorSATMgr *smgr;
+  BtorIntHashTableIterator it;
+
+  smgr    = btor_get_sat_mgr (btor);
+  nseeded = 0;
+  btor_iter_hashint_init (&it, phases);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    bv  = phases->data[it.cur_pos].as_ptr;
+    id  = btor_iter_hashint_next (&it);
+    var = id > 0 ? btor_node_get_by_id (btor, id) : 0;
+    if (!var || !btor_node_is_bv_var (var) || !var->av) continue;
+    width = var->av->width;
+    assert (width == btor_bv_get_width (bv));
+    for (i = 0; i < width; i++)
+    {
+      aig = var->av->aigs[i];
+      if (btor_aig_is_const (aig)) continue;
+      lit = btor_aig_get_cnf_id (aig);
+      if (!lit) continue;
+      btor_sat_phase (smgr, btor_bv_get_bit (bv, width - 1 - i) ? lit : -lit);
+      nseeded += 1;
+    }
+  }
+  BTOR_MSG (btor->msg, 1, "seeded phases of %u SAT variables", nseeded);
+}
+
 static BtorSolverResult
 timed_sat_sat (Btor *btor, int32_t limit)
 {
@@ -331,30 +490,44 @@ get_bv_assignment (Btor *btor, BtorNode *exp)
 
 /*------------------------------------------------------------------------*/
 
+/* The dual prop clone is kept as long as the constraints of 'btor' only
+ * grow.  If a constraint that is already part of the clone was removed
+ * (e.g., it got rewritten due to substitution), the clone is stale. */
+static bool
+is_dual_prop_clone_stale (Btor *btor)
+{
+  BtorNode *cur;
+  BtorFunSolver *slv;
+  BtorPtrHashTableIterator it;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  btor_iter_hashptr_init (&it, slv->dp_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (!btor_hashptr_table_get (btor->synthesized_constraints, cur)
+        && !btor_hashptr_table_get (btor->unsynthesized_constraints, cur))
+      return true;
+  }
+  return false;
+}
+
 static Btor *
-new_exp_layer_clone_for_dual_prop (Btor *btor,
-                                   BtorNodeMap **exp_map,
-                                   BtorNode **root)
+new_exp_layer_clone_for_dual_prop (Btor *btor)
 {
   assert (btor);
   assert (btor->slv);
   assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
-  assert (exp_map);
-  assert (root);
 
-  double start;
   Btor *clone;
-  BtorNode *cur, *and;
+  BtorNode *cur;
+  BtorFunSolver *slv;
   BtorPtrHashTableIterator it;
 
-  /* empty formula */
-  if (btor->unsynthesized_constraints->count == 0) return 0;
-
-  start = btor_util_time_stamp ();
-  clone = btor_clone_exp_layer (btor, exp_map, true);
+  slv   = BTOR_FUN_SOLVER (btor);
+  clone = btor_clone_exp_layer (btor, &slv->dp_exp_map, true);
   assert (!clone->synthesized_constraints->count);
   assert (clone->embedded_constraints->count == 0);
-  assert (clone->unsynthesized_constraints->count);
 
   btor_opt_set (clone, BTOR_OPT_MODEL_GEN, 0);
   btor_opt_set (clone, BTOR_OPT_INCREMENTAL, 1);
@@ -366,28 +539,16 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
   btor_opt_set_str (clone, BTOR_OPT_SAT_ENGINE, "plain=1");
   configure_sat_mgr (clone);
 
+  /* constraints and assumptions are conjoined to the roots of the clone
+   * when syncing */
   btor_iter_hashptr_init (&it, clone->unsynthesized_constraints);
   btor_iter_hashptr_queue (&it, clone->assumptions);
   while (btor_iter_hashptr_has_next (&it))
   {
     cur                                   = btor_iter_hashptr_next (&it);
     btor_node_real_addr (cur)->constraint = 0;
-    if (!*root)
-    {
-      *root = btor_node_copy (clone, cur);
-    }
-    else
-    {
-      and = btor_exp_bv_and (clone, *root, cur);
-      btor_node_release (clone, *root);
-      *root = and;
-    }
+    btor_node_release (clone, cur);
   }
-
-  btor_iter_hashptr_init (&it, clone->unsynthesized_constraints);
-  btor_iter_hashptr_queue (&it, clone->assumptions);
-  while (btor_iter_hashptr_has_next (&it))
-    btor_node_release (clone, btor_iter_hashptr_next (&it));
   btor_hashptr_table_delete (clone->unsynthesized_constraints);
   btor_hashptr_table_delete (clone->assumptions);
   clone->unsynthesized_constraints =
@@ -399,8 +560,96 @@ new_exp_layer_clone_for_dual_prop (Btor *btor,
                               (BtorHashPtr) btor_node_hash_by_id,
                               (BtorCmpPtr) btor_node_compare_by_id);
 
-  BTOR_FUN_SOLVER (btor)->time.search_init_apps_cloning +=
-      btor_util_time_stamp () - start;
+  slv->dp_clone       = clone;
+  slv->dp_root        = 0;
+  slv->dp_constraints = btor_hashptr_table_new (
+      btor->mm,
+      (BtorHashPtr) btor_node_hash_by_id,
+      (BtorCmpPtr) btor_node_compare_by_id);
+  slv->dp_assumed = btor_hashptr_table_new (
+      btor->mm,
+      (BtorHashPtr) btor_node_hash_by_id,
+      (BtorCmpPtr) btor_node_compare_by_id);
+  slv->stats.dp_clones += 1;
+  return clone;
+}
+
+static void
+conjoin_to_dual_prop_root (Btor *btor,
+                           Btor *clone,
+                           BtorNode **root,
+                           BtorNode *exp,
+                           BtorNodeMap *exp_map)
+{
+  BtorNode *cexp, *and;
+
+  /* clone and rebuild with rewrite level 0 (as we want the exact
+   * expression) */
+  cexp = btor_clone_recursively_rebuild_exp (btor, clone, exp, exp_map, 0);
+  assert (cexp);
+  if (!*root)
+  {
+    *root = cexp;
+    return;
+  }
+  and = btor_exp_bv_and (clone, *root, cexp);
+  btor_node_release (clone, cexp);
+  btor_node_release (clone, *root);
+  *root = and;
+}
+
+/* Returns the expression layer clone for dual propagation and its root for
+ * the current sat call.  The clone is created once and new constraints are
+ * added incrementally via 'slv->dp_exp_map', the assumptions of the current
+ * call are only conjoined to the returned root. */
+static Btor *
+sync_exp_layer_clone_for_dual_prop (Btor *btor, BtorNode **root)
+{
+  assert (btor);
+  assert (btor->slv);
+  assert (btor->slv->kind == BTOR_FUN_SOLVER_KIND);
+  assert (root);
+
+  double start;
+  Btor *clone;
+  BtorNode *cur;
+  BtorFunSolver *slv;
+  BtorPtrHashTableIterator it;
+
+  slv = BTOR_FUN_SOLVER (btor);
+
+  if (slv->dp_clone && is_dual_prop_clone_stale (btor))
+    delete_dual_prop_clone (slv);
+
+  /* empty formula */
+  if (btor->unsynthesized_constraints->count == 0
+      && btor->synthesized_constraints->count == 0)
+    return 0;
+
+  start = btor_util_time_stamp ();
+
+  clone = slv->dp_clone;
+  if (!clone) clone = new_exp_layer_clone_for_dual_prop (btor);
+
+  btor_iter_hashptr_init (&it, btor->synthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->unsynthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    cur = btor_iter_hashptr_next (&it);
+    if (btor_hashptr_table_get (slv->dp_constraints, cur)) continue;
+    btor_hashptr_table_add (slv->dp_constraints, btor_node_copy (btor, cur));
+    conjoin_to_dual_prop_root (
+        btor, clone, &slv->dp_root, cur, slv->dp_exp_map);
+  }
+  assert (slv->dp_root);
+
+  *root = btor_node_copy (clone, slv->dp_root);
+  btor_iter_hashptr_init (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    conjoin_to_dual_prop_root (
+        btor, clone, root, btor_iter_hashptr_next (&it), slv->dp_exp_map);
+
+  slv->time.search_init_apps_cloning += btor_util_time_stamp () - start;
   return clone;
 }
 
@@ -423,7 +672,10 @@ assume_inputs (Btor *btor,
   uint32_t i;
   BtorNode *cur_btor, *cur_clone, *bv_const, *bv_eq;
   BtorBitVector *bv;
+  BtorFunSolver *slv;
+  BtorPtrHashBucket *b;
 
+  slv = BTOR_FUN_SOLVER (btor);
   for (i = 0; i < BTOR_COUNT_STACK (*inputs); i++)
   {
     cur_btor  = BTOR_PEEK_STACK (*inputs, i);
@@ -445,6 +697,21 @@ assume_inputs (Btor *btor,
              btor_util_node2string (bv_const));
     btor_assume_exp (clone, bv_eq);
     btor_nodemap_map (assumptions, bv_eq, cur_clone);
+    /* keep the equality of the current assignment alive, if the assignment
+     * of the input does not change, it is neither rebuilt nor encoded to
+     * CNF again in the next refinement iteration or sat call */
+    b = btor_hashptr_table_get (slv->dp_assumed, cur_clone);
+    if (!b)
+    {
+      b = btor_hashptr_table_add (slv->dp_assumed,
+                                  btor_node_copy (clone, cur_clone));
+      b->data.as_ptr = btor_node_copy (clone, bv_eq);
+    }
+    else if (b->data.as_ptr != bv_eq)
+    {
+      btor_node_release (clone, b->data.as_ptr);
+      b->data.as_ptr = btor_node_copy (clone, bv_eq);
+    }
     btor_node_release (clone, bv_const);
     btor_node_release (clone, bv_eq);
   }
@@ -917,20 +1184,81 @@ add_lemma_to_dual_prop_clone (Btor *btor,
   assert (clone);
   assert (lemma);
 
-  BtorNode *clemma, *and;
-
-  /* clone and rebuild lemma with rewrite level 0 (as we want the exact
-   * expression) */
-  clemma = btor_clone_recursively_rebuild_exp (btor, clone, lemma, exp_map, 0);
-  assert (clemma);
-  and = btor_exp_bv_and (clone, *root, clemma);
-  btor_node_release (clone, clemma);
-  btor_node_release (clone, *root);
-  *root = and;
+  conjoin_to_dual_prop_root (btor, clone, root, lemma, exp_map);
 }
 
 /*------------------------------------------------------------------------*/
 
+static void
+collect_applies_bv_skeleton (Btor *btor,
+                             BtorNode *root,
+                             BtorNodePtrStack *applies,
+                             BtorIntHashTable *cache,
+                             BtorIntHashTable *skip,
+                             bool copy)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack stack;
+
+  BTOR_INIT_STACK (btor->mm, stack);
+  BTOR_PUSH_STACK (stack, root);
+  while (!BTOR_EMPTY_STACK (stack))
+  {
+    cur = BTOR_POP_STACK (stack);
+    assert (!btor_node_is_simplified (cur)
+            || btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST));
+    cur = btor_node_real_addr (btor_node_get_simplified (btor, cur));
+
+    if (btor_hashint_table_contains (cache, cur->id)) continue;
+    if (skip && btor_hashint_table_contains (skip, cur->id)) continue;
+
+    btor_hashint_table_add (cache, cur->id);
+
+    if (btor_node_is_apply (cur) && !cur->parameterized)
+    {
+      //	      assert (btor_node_is_synth (cur));
+      BTORLOG (1, "initial apply: %s", btor_util_node2string (cur));
+      BTOR_PUSH_STACK (*applies, copy ? btor_node_copy (btor, cur) : cur);
+      continue;
+    }
+
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (stack, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (stack);
+}
+
+/* Drop applies collected in previous sat calls that have been simplified in
+ * the meantime (e.g. by incremental beta reduction or substitution).  Their
+ * simplified representation is reachable from the rewritten constraints and
+ * is collected again. */
+static void
+prune_init_apps (Btor *btor)
+{
+  uint32_t i, j;
+  BtorNode *app;
+  BtorFunSolver *slv;
+
+  slv = BTOR_FUN_SOLVER (btor);
+  for (i = 0, j = 0; i < BTOR_COUNT_STACK (slv->init_apps); i++)
+  {
+    app = BTOR_PEEK_STACK (slv->init_apps, i);
+    if (btor_node_is_simplified (app))
+    {
+      btor_hashint_table_remove (slv->init_apps_cache, app->id);
+      btor_node_release (btor, app);
+      continue;
+    }
+    BTOR_POKE_STACK (slv->init_apps, j, app);
+    j++;
+  }
+  slv->init_apps.top = slv->init_apps.start + j;
+}
+
+/* The applies in the bv skeleton of the synthesized constraints are kept in
+ * 'slv->init_apps' across sat calls since constraints are never removed,
+ * only the (usually small) cones of the assumptions are traversed in every
+ * call.  The latter are collected in 'applies'. */
 static void
 search_initial_applies_bv_skeleton (Btor *btor,
                                     BtorNodePtrStack *applies,
@@ -942,53 +1270,34 @@ search_initial_applies_bv_skeleton (Btor *btor,
   assert (applies);
 
   double start;
-  uint32_t i;
-  BtorNode *cur;
-  BtorNodePtrStack stack;
   BtorPtrHashTableIterator it;
-  BtorMemMgr *mm;
+  BtorFunSolver *slv;
 
   start = btor_util_time_stamp ();
+  slv   = BTOR_FUN_SOLVER (btor);
 
   BTORLOG (1, "");
   BTORLOG (1, "*** search initial applies");
 
-  mm = btor->mm;
-  BTOR_INIT_STACK (mm, stack);
-
   btor_iter_hashptr_init (&it, btor->synthesized_constraints);
-  btor_iter_hashptr_queue (&it, btor->assumptions);
   while (btor_iter_hashptr_has_next (&it))
-  {
-    cur = btor_iter_hashptr_next (&it);
-    BTOR_PUSH_STACK (stack, cur);
-
-    while (!BTOR_EMPTY_STACK (stack))
-    {
-      cur = BTOR_POP_STACK (stack);
-      assert (!btor_node_is_simplified (cur)
-              || btor_opt_get (btor, BTOR_OPT_NONDESTR_SUBST));
-      cur = btor_node_real_addr (btor_node_get_simplified (btor, cur));
-
-      if (btor_hashint_table_contains (cache, cur->id)) continue;
-
-      btor_hashint_table_add (cache, cur->id);
-
-      if (btor_node_is_apply (cur) && !cur->parameterized)
-      {
-        //	      assert (btor_node_is_synth (cur));
-        BTORLOG (1, "initial apply: %s", btor_util_node2string (cur));
-        BTOR_PUSH_STACK (*applies, cur);
-        continue;
-      }
-
-      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (stack, cur->e[i]);
-    }
-  }
+    collect_applies_bv_skeleton (btor,
+                                 btor_iter_hashptr_next (&it),
+                                 &slv->init_apps,
+                                 slv->init_apps_cache,
+                                 0,
+                                 true);
+
+  btor_iter_hashptr_init (&it, btor->assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    collect_applies_bv_skeleton (btor,
+                                 btor_iter_hashptr_next (&it),
+                                 applies,
+                                 cache,
+                                 slv->init_apps_cache,
+                                 false);
 
-  BTOR_RELEASE_STACK (stack);
-  BTOR_FUN_SOLVER (btor)->time.search_init_apps +=
-      btor_util_time_stamp () - start;
+  slv->time.search_init_apps += btor_util_time_stamp () - start;
 }
 
 static void
@@ -1633,6 +1942,260 @@ find_conflict_app (Btor *btor, BtorNode *app, BtorIntHashTable *conf_apps)
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+/* Index for chains of update nodes.
+ *
+ * Propagating an apply over an update chain step by step is linear in the
+ * length of the chain, for each apply and in every refinement round.  For
+ * each chain, we instead index the update levels by the assignment of their
+ * arguments, which allows to jump to the first update below a given level
+ * that writes to the argument assignment of the propagated apply in
+ * logarithmic time.  Chains are built lazily and the index of a chain is
+ * shared by all applies on a common suffix of the chain.  Since it depends
+ * on the current assignment, the index is only valid during one call to
+ * 'propagate'.
+ */
+
+struct BtorUpdateChain
+{
+  BtorNodePtrStack updates; /* update levels, from bottom to top */
+  BtorNode *base;           /* function below the bottom level */
+  BtorPtrHashTable *depths; /* args -> levels with equal assignment */
+  BtorIntStack unpushed;    /* links to the next level below whose indices
+                               and values have not been searched for applies
+                               yet (path compressed) */
+};
+
+typedef struct BtorUpdateChain BtorUpdateChain;
+
+BTOR_DECLARE_STACK (BtorUpdateChainPtr, BtorUpdateChain *);
+
+struct BtorUpdateChains
+{
+  Btor *btor;
+  BtorUpdateChainPtrStack chains;
+  BtorIntHashTable *node2chain; /* update id -> chain */
+  BtorIntHashTable *node2depth; /* update id -> level in chain */
+};
+
+typedef struct BtorUpdateChains BtorUpdateChains;
+
+static BtorUpdateChains *
+new_update_chains (Btor *btor)
+{
+  BtorUpdateChains *res;
+
+  BTOR_CNEW (btor->mm, res);
+  res->btor = btor;
+  BTOR_INIT_STACK (btor->mm, res->chains);
+  res->node2chain = btor_hashint_map_new (btor->mm);
+  res->node2depth = btor_hashint_map_new (btor->mm);
+  return res;
+}
+
+static void
+delete_update_chains (BtorUpdateChains *chains)
+{
+  BtorMemMgr *mm;
+  BtorUpdateChain *chain;
+  BtorIntStack *depths;
+  BtorPtrHashTableIterator it;
+
+  mm = chains->btor->mm;
+  while (!BTOR_EMPTY_STACK (chains->chains))
+  {
+    chain = BTOR_POP_STACK (chains->chains);
+    btor_iter_hashptr_init (&it, chain->depths);
+    while (btor_iter_hashptr_has_next (&it))
+    {
+      depths = it.bucket->data.as_ptr;
+      (void) btor_iter_hashptr_next (&it);
+      BTOR_RELEASE_STACK (*depths);
+      BTOR_DELETE (mm, depths);
+    }
+    btor_hashptr_table_delete (chain->depths);
+    BTOR_RELEASE_STACK (chain->updates);
+    BTOR_RELEASE_STACK (chain->unpushed);
+    BTOR_DELETE (mm, chain);
+  }
+  BTOR_RELEASE_STACK (chains->chains);
+  btor_hashint_map_delete (chains->node2chain);
+  btor_hashint_map_delete (chains->node2depth);
+  BTOR_DELETE (mm, chains);
+}
+
+static void
+add_update_to_chain (BtorUpdateChains *chains,
+                     BtorUpdateChain *chain,
+                     BtorNode *upd)
+{
+  assert (btor_node_is_update (upd));
+
+  int32_t depth;
+  BtorMemMgr *mm;
+  BtorNode *args;
+  BtorIntStack *depths;
+  BtorPtrHashBucket *b;
+
+  mm    = chains->btor->mm;
+  depth = BTOR_COUNT_STACK (chain->updates);
+  BTOR_PUSH_STACK (chain->updates, upd);
+  BTOR_PUSH_STACK (chain->unpushed, depth);
+
+  args = btor_node_get_simplified (chains->btor, upd->e[1]);
+  b    = btor_hashptr_table_get (chain->depths, args);
+  if (!b)
+  {
+    BTOR_NEW (mm, depths);
+    BTOR_INIT_STACK (mm, *depths);
+    b              = btor_hashptr_table_add (chain->depths, args);
+    b->data.as_ptr = depths;
+  }
+  depths = b->data.as_ptr;
+  BTOR_PUSH_STACK (*depths, depth);
+
+  /* levels on a suffix shared with another chain keep their first chain */
+  if (!btor_hashint_map_contains (chains->node2chain, upd->id))
+  {
+    btor_hashint_map_add (chains->node2chain, upd->id)->as_ptr = chain;
+    btor_hashint_map_add (chains->node2depth, upd->id)->as_int = depth;
+  }
+}
+
+static BtorUpdateChain *
+get_update_chain (BtorUpdateChains *chains, BtorNode *upd, int32_t *depth)
+{
+  assert (btor_node_is_update (upd));
+
+  Btor *btor;
+  BtorNode *cur;
+  BtorUpdateChain *chain = 0;
+  BtorNodePtrStack visit;
+  BtorHashTableData *d;
+
+  btor = chains->btor;
+
+  if (!btor_hashint_map_contains (chains->node2chain, upd->id))
+  {
+    BTOR_INIT_STACK (btor->mm, visit);
+    cur = upd;
+    while (btor_node_is_update (cur)
+           && !btor_hashint_map_contains (chains->node2chain, cur->id))
+    {
+      BTOR_PUSH_STACK (visit, cur);
+      cur = btor_node_get_simplified (btor, cur->e[0]);
+    }
+    /* extend existing chain if we reached its top level */
+    if (btor_node_is_update (cur))
+    {
+      chain = btor_hashint_map_get (chains->node2chain, cur->id)->as_ptr;
+      d     = btor_hashint_map_get (chains->node2depth, cur->id);
+      if ((uint32_t) d->as_int + 1 != BTOR_COUNT_STACK (chain->updates))
+      {
+        chain = 0;
+        while (btor_node_is_update (cur))
+        {
+          BTOR_PUSH_STACK (visit, cur);
+          cur = btor_node_get_simplified (btor, cur->e[0]);
+        }
+      }
+    }
+    if (!chain)
+    {
+      BTOR_CNEW (btor->mm, chain);
+      BTOR_INIT_STACK (btor->mm, chain->updates);
+      BTOR_INIT_STACK (btor->mm, chain->unpushed);
+      chain->base   = cur;
+      chain->depths = btor_hashptr_table_new (
+          btor->mm,
+          (BtorHashPtr) hash_args_assignment,
+          (BtorCmpPtr) compare_args_assignments);
+      BTOR_PUSH_STACK (chains->chains, chain);
+    }
+    while (!BTOR_EMPTY_STACK (visit))
+      add_update_to_chain (chains, chain, BTOR_POP_STACK (visit));
+    BTOR_RELEASE_STACK (visit);
+  }
+
+  chain  = btor_hashint_map_get (chains->node2chain, upd->id)->as_ptr;
+  *depth = btor_hashint_map_get (chains->node2depth, upd->id)->as_int;
+  assert (BTOR_PEEK_STACK (chain->updates, *depth) == upd);
+  return chain;
+}
+
+static int32_t
+find_unpushed_level (BtorUpdateChain *chain, int32_t depth)
+{
+  int32_t root, next;
+
+  root = depth;
+  while (root >= 0 && BTOR_PEEK_STACK (chain->unpushed, root) != root)
+    root = BTOR_PEEK_STACK (chain->unpushed, root);
+  while (depth >= 0 && depth != root)
+  {
+    next = BTOR_PEEK_STACK (chain->unpushed, depth);
+    BTOR_POKE_STACK (chain->unpushed, depth, root);
+    depth = next;
+  }
+  return root;
+}
+
+/* Returns the first function below update 'upd' where an apply with
+ * arguments 'args' has to be propagated to, i.e., the first update below
+ * 'upd' that writes to the assignment of 'args' or the base of the chain.
+ * Applies in the indices and values of the skipped levels are pushed for
+ * propagation, as if the apply was propagated level by level. */
+static BtorNode *
+find_update_target (BtorUpdateChains *chains,
+                    BtorNode *upd,
+                    BtorNode *args,
+                    BtorNodePtrStack *prop_stack,
+                    BtorIntHashTable *apply_search_cache)
+{
+  int32_t depth, target, lo, hi, mid, i;
+  Btor *btor;
+  BtorNode *cur;
+  BtorUpdateChain *chain;
+  BtorIntStack *depths;
+  BtorPtrHashBucket *b;
+
+  btor   = chains->btor;
+  chain  = get_update_chain (chains, upd, &depth);
+  target = -1;
+
+  /* find last level below 'depth' with equal arguments assignment */
+  b = btor_hashptr_table_get (chain->depths, args);
+  if (b)
+  {
+    depths = b->data.as_ptr;
+    lo     = 0;
+    hi     = BTOR_COUNT_STACK (*depths);
+    while (lo < hi)
+    {
+      mid = lo + (hi - lo) / 2;
+      if (BTOR_PEEK_STACK (*depths, mid) < depth)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    if (lo > 0) target = BTOR_PEEK_STACK (*depths, lo - 1);
+  }
+
+  for (i = find_unpushed_level (chain, depth - 1); i > target;
+       i = find_unpushed_level (chain, i - 1))
+  {
+    cur = BTOR_PEEK_STACK (chain->updates, i);
+    push_applies_for_propagation (
+        btor, cur->e[1], prop_stack, apply_search_cache);
+    push_applies_for_propagation (
+        btor, cur->e[2], prop_stack, apply_search_cache);
+    BTOR_POKE_STACK (chain->unpushed, i, i - 1);
+  }
+
+  BTOR_FUN_SOLVER (btor)->stats.propagations_skipped += depth - target - 1;
+  return target >= 0 ? BTOR_PEEK_STACK (chain->updates, target) : chain->base;
+}
+
 static void
 propagate (Btor *btor,
            BtorNodePtrStack *prop_stack,
@@ -1658,12 +2221,14 @@ propagate (Btor *btor,
   BtorPtrHashTableIterator it;
   BtorPtrHashTable *conds;
   BtorIntHashTable *conf_apps;
+  BtorUpdateChains *chains;
 
   start            = btor_util_time_stamp ();
   mm               = btor->mm;
   slv              = BTOR_FUN_SOLVER (btor);
   conf_apps        = btor_hashint_table_new (mm);
   opt_eager_lemmas = btor_opt_get (btor, BTOR_OPT_FUN_EAGER_LEMMAS);
+  chains           = 0;
 
   BTORLOG (1, "");
   BTORLOG (1, "*** %s", __FUNCTION__);
@@ -1808,9 +2373,18 @@ propagate (Btor *btor,
       }
       else
       {
+        cur = fun->e[0];
+        /* jump over the levels of update chains that do not write to
+         * 'args' */
+        if (btor_node_is_update (btor_node_get_simplified (btor, cur)))
+        {
+          if (!chains) chains = new_update_chains (btor);
+          cur = find_update_target (
+              chains, fun, args, prop_stack, apply_search_cache);
+        }
         app->propagated = 0;
         BTOR_PUSH_STACK (*prop_stack, app);
-        BTOR_PUSH_STACK (*prop_stack, fun->e[0]);
+        BTOR_PUSH_STACK (*prop_stack, cur);
         slv->stats.propagations_down++;
       }
       push_applies_for_propagation (
@@ -1899,6 +2473,7 @@ propagate (Btor *btor,
     if (restart && conflict) break;
   }
   btor_hashint_table_delete (conf_apps);
+  if (chains) delete_update_chains (chains);
   slv->time.prop += btor_util_time_stamp () - start;
 }
 
@@ -2322,6 +2897,22 @@ check_and_resolve_conflicts (Btor *btor,
     BTORLOG (2, "push apply: %s", btor_util_node2string (app));
   }
 
+  if (init_apps != &top_applies)
+  {
+    /* applies in the cone of the constraints are propagated first */
+    for (i = BTOR_COUNT_STACK (slv->init_apps) - 1; i >= 0; i--)
+    {
+      app = BTOR_PEEK_STACK (slv->init_apps, i);
+      assert (btor_node_is_regular (app));
+      assert (btor_node_is_apply (app));
+      assert (!app->parameterized);
+      assert (!app->propagated);
+      BTOR_PUSH_STACK (prop_stack, app);
+      BTOR_PUSH_STACK (prop_stack, app->e[0]);
+      BTORLOG (2, "push apply: %s", btor_util_node2string (app));
+    }
+  }
+
   propagate (btor, &prop_stack, cleanup_table, apply_search_cache);
   found_conflicts = BTOR_COUNT_STACK (slv->cur_lemmas) > 0;
 
@@ -2406,6 +2997,20 @@ reset_lemma_cache (BtorFunSolver *slv)
                                         (BtorCmpPtr) btor_node_compare_by_id);
 }
 
+/* Lemmas are valid independent of the current assumptions, hence instead of
+ * regenerating them in every call they can be assumed again. */
+static void
+assume_lemmas_again (BtorFunSolver *slv)
+{
+  Btor *btor;
+  BtorPtrHashTableIterator it;
+
+  btor = slv->btor;
+  btor_iter_hashptr_init (&it, slv->lemmas);
+  while (btor_iter_hashptr_has_next (&it))
+    btor_assume_exp (btor, btor_iter_hashptr_next (&it));
+}
+
 static BtorSolverResult
 sat_fun_solver (BtorFunSolver *slv)
 {
@@ -2420,7 +3025,7 @@ sat_fun_solver (BtorFunSolver *slv)
   Btor *btor, *clone;
   BtorNode *clone_root, *lemma;
   BtorNodeMap *exp_map;
-  BtorIntHashTable *init_apps_cache;
+  BtorIntHashTable *init_apps_cache, *phases;
   BtorNodePtrStack init_apps;
 
   btor = slv->btor;
@@ -2434,6 +3039,7 @@ sat_fun_solver (BtorFunSolver *slv)
   clone      = 0;
   clone_root = 0;
   exp_map    = 0;
+  phases     = 0;
 
   if ((btor_opt_get (btor, BTOR_OPT_FUN_PREPROP)
        || btor_opt_get (btor, BTOR_OPT_FUN_PRESLS))
@@ -2476,6 +3082,9 @@ sat_fun_solver (BtorFunSolver *slv)
                 result == BTOR_RESULT_SAT ? "'sat'" : "'unsat'");
       goto DONE;
     }
+    /* keep the best assignment found as phases for the SAT solver */
+    if (btor_opt_get (btor, BTOR_OPT_FUN_PRESEED) && btor->bv_model)
+      phases = btor_model_clone_bv (btor, btor->bv_model, true);
     /* reset */
     btor_model_delete (btor);
   }
@@ -2488,15 +3097,24 @@ sat_fun_solver (BtorFunSolver *slv)
   }
 
   configure_sat_mgr (btor);
+  btor_sat_gc (btor);
 
-  if (slv->assume_lemmas) reset_lemma_cache (slv);
+  if (slv->assume_lemmas)
+  {
+    if (btor_opt_get (btor, BTOR_OPT_FUN_KEEP_LEMMAS))
+      assume_lemmas_again (slv);
+    else
+      reset_lemma_cache (slv);
+  }
+  prune_init_apps (btor);
 
   if (btor->feqs->count > 0) add_function_inequality_constraints (btor);
 
   /* initialize dual prop clone */
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
-    clone = new_exp_layer_clone_for_dual_prop (btor, &exp_map, &clone_root);
+    clone = sync_exp_layer_clone_for_dual_prop (btor, &clone_root);
+    exp_map = slv->dp_exp_map;
   }
 
   while (true)
@@ -2519,6 +3137,12 @@ sat_fun_solver (BtorFunSolver *slv)
     assert (btor_dbg_check_all_hash_tables_proxy_free (btor));
     assert (btor_dbg_check_all_hash_tables_simp_free (btor));
 
+    if (phases)
+    {
+      seed_phases (btor, phases);
+      btor_model_delete_bv (btor, &phases);
+    }
+
     /* make SAT call on bv skeleton */
     btor_add_again_assumptions (btor);
     result = timed_sat_sat (btor, slv->sat_limit);
@@ -2577,14 +3201,9 @@ sat_fun_solver (BtorFunSolver *slv)
 DONE:
   BTOR_RELEASE_STACK (init_apps);
   btor_hashint_table_delete (init_apps_cache);
+  if (phases) btor_model_delete_bv (btor, &phases);
 
-  if (clone)
-  {
-    assert (exp_map);
-    btor_nodemap_delete (exp_map);
-    btor_node_release (clone, clone_root);
-    btor_delete (clone);
-  }
+  if (clone) btor_node_release (clone, clone_root);
   return result;
 }
 
@@ -2678,6 +3297,10 @@ print_stats_fun_solver (BtorFunSolver *slv)
   BTOR_MSG (btor->msg, 1, "%7lld propagations", slv->stats.propagations);
   BTOR_MSG (
       btor->msg, 1, "%7lld propagations down", slv->stats.propagations_down);
+  BTOR_MSG (btor->msg,
+            1,
+            "%7lld update levels skipped",
+            slv->stats.propagations_skipped);
 
   if (btor_opt_get (btor, BTOR_OPT_FUN_DUAL_PROP))
   {
@@ -2691,6 +3314,7 @@ print_stats_fun_solver (BtorFunSolver *slv)
               "%d/%d dual prop. applies (failed/assumed)",
               slv->stats.dp_failed_applies,
               slv->stats.dp_assumed_applies);
+    BTOR_MSG (btor->msg, 1, "%d dual prop. clones", slv->stats.dp_clones);
   }
 }
 
@@ -2819,6 +3443,9 @@ btor_new_fun_solver (Btor *btor)
                                         (BtorCmpPtr) btor_node_compare_by_id);
   BTOR_INIT_STACK (btor->mm, slv->cur_lemmas);
 
+  BTOR_INIT_STACK (btor->mm, slv->init_apps);
+  slv->init_apps_cache = btor_hashint_table_new (btor->mm);
+
   BTOR_INIT_STACK (btor->mm, slv->stats.lemmas_size);
 
   BTOR_MSG (btor->msg, 1, "enabled core engine");
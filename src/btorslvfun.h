@@ -12,7 +12,9 @@
 
 #include "btornode.h"
 #include "btorslv.h"
+#include "utils/btorhashint.h"
 #include "utils/btorhashptr.h"
+#include "utils/btornodemap.h"
 
 #define BTOR_FUN_SOLVER(btor) ((BtorFunSolver *) (btor)->slv)
 
@@ -23,6 +25,18 @@ struct BtorFunSolver
   BtorPtrHashTable *lemmas;
   BtorNodePtrStack cur_lemmas;
 
+  /* applies in the bv skeleton of the synthesized constraints, kept across
+   * sat calls since constraints are never removed */
+  BtorNodePtrStack init_apps;
+  BtorIntHashTable *init_apps_cache;
+
+  /* expression layer clone for dual propagation, kept across sat calls */
+  Btor *dp_clone;
+  BtorNodeMap *dp_exp_map;          /* maps nodes to 'dp_clone' */
+  BtorNode *dp_root;                /* conjunction of synced constraints */
+  BtorPtrHashTable *dp_constraints; /* constraints synced to 'dp_root' */
+  BtorPtrHashTable *dp_assumed;     /* input -> last assumed equality */
+
   BtorPtrHashTable *score; /* dcr score */
 
   // TODO (ma): make options for these
@@ -50,10 +64,12 @@ struct BtorFunSolver
     uint32_t dp_assumed_applies;
     uint32_t dp_failed_eqs;
     uint32_t dp_assumed_eqs;
+    uint32_t dp_clones; /* number of dual prop clones created */
 
     uint_least64_t eval_exp_calls;
     uint_least64_t propagations;
     uint_least64_t propagations_down;
+    uint_least64_t propagations_skipped; /* update levels skipped via index */
   } stats;
 
   struct
@@ -168,6 +168,7 @@ move (Btor *btor, uint32_t nmoves)
   btor_hashint_map_add (exps, input->id)->as_ptr = assignment;
   btor_lsutils_update_cone (
       btor,
+      slv->index,
       btor->bv_model,
       slv->roots,
       btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT) ? slv->score : 0,
@@ -206,6 +207,8 @@ clone_prop_solver (Btor *clone, BtorPropSolver *slv, BtorNodeMap *exp_map)
   res->roots = btor_hashint_map_clone (clone->mm, slv->roots, 0, 0);
   res->score =
       btor_hashint_map_clone (clone->mm, slv->score, btor_clone_data_as_dbl, 0);
+  res->index     = 0;
+  res->inv_cache = 0;
 
   return res;
 }
@@ -220,6 +223,8 @@ delete_prop_solver (BtorPropSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  if (slv->index) btor_lsutils_index_delete (slv->index);
+  if (slv->inv_cache) btor_proputils_inv_cache_delete (slv->inv_cache);
 
   BTOR_DELETE (slv->btor->mm, slv);
 }
@@ -238,6 +243,7 @@ sat_prop_solver_aux (Btor *btor)
   uint32_t j, max_steps;
   int32_t sat_result;
   uint32_t nmoves, nprops;
+  bool save_best;
   BtorNode *root;
   BtorPtrHashTableIterator it;
   BtorPropSolver *slv;
@@ -245,6 +251,8 @@ sat_prop_solver_aux (Btor *btor)
   slv = BTOR_PROP_SOLVER (btor);
   assert (slv);
   nprops = btor_opt_get (btor, BTOR_OPT_PROP_NPROPS);
+  /* the best assignment is used to seed the SAT solver phases */
+  save_best = btor_opt_get (btor, BTOR_OPT_FUN_PRESEED);
 
   nmoves = 0;
 
@@ -263,6 +271,11 @@ sat_prop_solver_aux (Btor *btor)
       goto UNSAT;
   }
 
+  assert (!slv->index);
+  slv->index = btor_lsutils_index_new (btor);
+  assert (!slv->inv_cache);
+  slv->inv_cache = btor_proputils_inv_cache_new (btor->mm);
+
   for (;;)
   {
     /* collect unsatisfied roots (kept up-to-date in update_cone) */
@@ -296,6 +309,9 @@ sat_prop_solver_aux (Btor *btor)
     /* all constraints sat? */
     if (!slv->roots->count) goto SAT;
 
+    if (save_best)
+      btor_lsutils_index_save_best (btor, slv->index, slv->roots->count);
+
     /* compute initial sls score */
     if (btor_opt_get (btor, BTOR_OPT_PROP_USE_BANDIT))
       btor_slsutils_compute_sls_scores (
@@ -325,6 +341,9 @@ sat_prop_solver_aux (Btor *btor)
 
       /* all constraints sat? */
       if (!slv->roots->count) goto SAT;
+
+      if (save_best)
+        btor_lsutils_index_save_best (btor, slv->index, slv->roots->count);
     }
 
     /* restart */
@@ -357,6 +376,18 @@ DONE:
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->index)
+  {
+    if (sat_result == BTOR_RESULT_UNKNOWN)
+      btor_lsutils_index_restore_best (btor, slv->index);
+    btor_lsutils_index_delete (slv->index);
+    slv->index = 0;
+  }
+  if (slv->inv_cache)
+  {
+    btor_proputils_inv_cache_delete (slv->inv_cache);
+    slv->inv_cache = 0;
+  }
   return sat_result;
 }
 
@@ -381,10 +412,11 @@ sat_prop_solver (BtorPropSolver *slv)
     goto DONE;
   }
 
-  BTOR_ABORT (btor->ufs->count != 0
+  BTOR_ABORT (btor->feqs->count != 0
                   || (!btor_opt_get (btor, BTOR_OPT_BETA_REDUCE)
                       && btor->lambdas->count != 0),
-              "prop engine supports QF_BV only");
+              "prop engine supports QF_BV and QF_ABV without extensionality "
+              "only");
 
   /* Generate intial model, all bv vars are initialized with zero. We do
    * not have to consider model_for_all_nodes, but let this be handled by
@@ -438,6 +470,14 @@ print_stats_prop_solver (BtorPropSolver *slv)
             slv->stats.props_cons);
   BTOR_MSG (
       btor->msg, 1, "   inverse value propagations: %u", slv->stats.props_inv);
+  BTOR_MSG (btor->msg,
+            1,
+            "   index value propagations: %u",
+            slv->stats.props_index);
+  BTOR_MSG (btor->msg,
+            1,
+            "   inverse value cache hits: %u",
+            slv->stats.inv_cache_hits);
   BTOR_MSG (btor->msg,
             1,
             "propagation (steps) per second: %.2f",
@@ -10,6 +10,7 @@
 #define BTORSLVPROP_H_INCLUDED
 
 #include "btorbv.h"
+#include "btorlsutils.h"
 #include "btorslv.h"
 #include "btortypes.h"
 #include "utils/btorhashint.h"
@@ -20,6 +21,10 @@ struct BtorPropSolver
 
   BtorIntHashTable *roots; /* map: maintains 'selected' */
   BtorIntHashTable *score;
+  BtorLsIndex *index; /* valid during sat call only */
+
+  /* inverse value cache, valid during sat call only */
+  struct BtorPropInvCache *inv_cache;
 
   /* current probability for selecting the cond when either the
    * 'then' or 'else' branch is const (path selection) */
@@ -37,9 +42,11 @@ struct BtorPropSolver
     uint32_t moves;
     uint32_t rec_conf;
     uint32_t non_rec_conf;
+    uint32_t inv_cache_hits;
     uint64_t props;
     uint64_t props_cons;
     uint64_t props_inv;
+    uint64_t props_index;
     uint64_t updates;
 
 #ifndef NDEBUG
@@ -39,6 +39,7 @@ struct BtorQuantStats
   {
     uint32_t refinements;
     uint32_t failed_refinements;
+    uint32_t imported_refinements;
 
     /* overall synthesize statistics */
     uint32_t synthesize_const;
@@ -65,6 +66,21 @@ struct BtorQuantStats
 
 typedef struct BtorQuantStats BtorQuantStats;
 
+/* Counterexample shared between the workers on the same (original or dual)
+ * formula.  Entries are pushed to the front of a singly linked list with a
+ * compare-and-swap and never removed while workers are running, hence
+ * readers can traverse the list without locking. */
+struct BtorQuantSharedCe
+{
+  struct BtorQuantSharedCe *next;
+  BtorMemMgr *mm;            /* memory manager of the producing worker */
+  uint32_t worker;           /* id of the producing worker */
+  BtorBitVectorTuple *ce;    /* values of universal vars */
+  BtorBitVectorTuple *evars; /* values of existential vars, may be 0 */
+};
+
+typedef struct BtorQuantSharedCe BtorQuantSharedCe;
+
 struct BtorGroundSolvers
 {
   Btor *forall; /* solver for checking the model */
@@ -93,20 +109,29 @@ struct BtorGroundSolvers
 
   BtorQuantStats statistics;
 
+  uint32_t id; /* worker id */
+  bool dual;   /* solves the dual formula */
+
 #ifdef BTOR_HAVE_PTHREADS
   bool *found_result;
   pthread_mutex_t *found_result_mutex;
+  BtorQuantSharedCe **shared_ces;    /* counterexamples of all workers on
+                                        the same formula, 0 if not shared */
+  BtorQuantSharedCe *shared_ces_seen; /* first already imported entry */
 #endif
 };
 
 typedef struct BtorGroundSolvers BtorGroundSolvers;
 
+BTOR_DECLARE_STACK (BtorGroundSolversPtr, BtorGroundSolvers *);
+
 struct BtorQuantSolver
 {
   BTOR_SOLVER_STRUCT;
 
   BtorGroundSolvers *gslv;  /* two ground solver instances */
   BtorGroundSolvers *dgslv; /* two ground solver instances for dual */
+  BtorGroundSolversPtrStack workers; /* additional workers (quant-workers) */
 };
 
 typedef struct BtorQuantSolver BtorQuantSolver;
@@ -963,58 +988,32 @@ instantiate_args (Btor *btor, BtorNode *args, BtorNodeMap *map)
   return res;
 }
 
-static void
-refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
+/* Build the refinement for counterexample 'ce' (values of the universal
+ * vars in the order of 'forall_uvars') in the exists solver. */
+static BtorNode *
+mk_refinement (BtorGroundSolvers *gslv, BtorBitVectorTuple *ce)
 {
-  assert (gslv->forall_uvars->table->count > 0);
+  assert (ce->arity == gslv->forall_uvars->table->count);
 
   uint32_t i;
-  Btor *f_solver, *e_solver;
+  Btor *e_solver;
   BtorNodeMap *map;
   BtorNodeMapIterator it;
-  BtorNode *var_es, *var_fs, *c, *res, *uvar, *evar, *a;
-  const BtorBitVector *bv;
-  BtorBitVectorTuple *ce, *evar_tup;
+  BtorNode *var_es, *var_fs, *c, *res, *uvar, *a;
 
-  f_solver = gslv->forall;
   e_solver = gslv->exists;
 
-  map = btor_nodemap_new (f_solver);
-
-  /* generate counter example for universal vars */
-  assert (f_solver->last_sat_result == BTOR_RESULT_SAT);
-  f_solver->slv->api.generate_model (f_solver->slv, false, false);
+  map = btor_nodemap_new (gslv->forall);
 
   /* instantiate universal vars with counter example */
-  i  = 0;
-  ce = btor_bv_new_tuple (f_solver->mm, gslv->forall_uvars->table->count);
+  i = 0;
   btor_iter_nodemap_init (&it, gslv->forall_uvars);
   while (btor_iter_nodemap_has_next (&it))
   {
-    var_fs = it.it.bucket->data.as_ptr;
-    uvar   = btor_iter_nodemap_next (&it);
-    bv     = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
-    c      = btor_exp_bv_const (e_solver, (BtorBitVector *) bv);
+    uvar = btor_iter_nodemap_next (&it);
+    c    = btor_exp_bv_const (e_solver, ce->bv[i++]);
     btor_nodemap_map (map, uvar, c);
     btor_node_release (e_solver, c);
-    btor_bv_add_to_tuple (f_solver->mm, ce, bv, i++);
-  }
-
-  i        = 0;
-  evar_tup = 0;
-  if (gslv->forall_evars->table->count)
-  {
-    evar_tup =
-        btor_bv_new_tuple (f_solver->mm, gslv->forall_evars->table->count);
-    btor_iter_nodemap_init (&it, gslv->forall_evars);
-    while (btor_iter_nodemap_has_next (&it))
-    {
-      evar   = btor_iter_nodemap_next (&it);
-      var_fs = btor_nodemap_mapped (evar_map, evar);
-      assert (var_fs);
-      bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
-      btor_bv_add_to_tuple (f_solver->mm, evar_tup, bv, i++);
-    }
   }
 
   /* map existential variables to skolem constants */
@@ -1050,6 +1049,166 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
   res = build_refinement (e_solver, gslv->forall_formula, map);
 
   btor_nodemap_delete (map);
+  return res;
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+/* Make counterexample available to all workers on the same formula. */
+static void
+export_ce (BtorGroundSolvers *gslv,
+           BtorBitVectorTuple *ce,
+           BtorBitVectorTuple *evar_tup)
+{
+  BtorMemMgr *mm;
+  BtorQuantSharedCe *shared;
+
+  if (!gslv->shared_ces) return;
+
+  mm = gslv->forall->mm;
+  BTOR_CNEW (mm, shared);
+  shared->mm     = mm;
+  shared->worker = gslv->id;
+  shared->ce     = btor_bv_copy_tuple (mm, ce);
+  shared->evars  = evar_tup ? btor_bv_copy_tuple (mm, evar_tup) : 0;
+
+  shared->next = __atomic_load_n (gslv->shared_ces, __ATOMIC_ACQUIRE);
+  while (!__atomic_compare_exchange_n (gslv->shared_ces,
+                                       &shared->next,
+                                       shared,
+                                       true,
+                                       __ATOMIC_RELEASE,
+                                       __ATOMIC_ACQUIRE))
+    ;
+}
+
+/* Check if shared counterexample matches the universal and existential
+ * vars of 'gslv'. */
+static bool
+is_compatible_ce (BtorGroundSolvers *gslv, BtorQuantSharedCe *shared)
+{
+  uint32_t i;
+  BtorNode *var;
+  BtorNodeMapIterator it;
+
+  if (shared->ce->arity != gslv->forall_uvars->table->count) return false;
+  if (shared->evars)
+  {
+    if (shared->evars->arity != gslv->forall_evars->table->count)
+      return false;
+  }
+  else if (gslv->forall_evars->table->count)
+    return false;
+
+  i = 0;
+  btor_iter_nodemap_init (&it, gslv->forall_uvars);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    var = btor_iter_nodemap_next (&it);
+    if (btor_node_bv_get_width (gslv->forall, var)
+        != btor_bv_get_width (shared->ce->bv[i++]))
+      return false;
+  }
+  return true;
+}
+
+/* Refine exists solver with the counterexamples found by other workers on
+ * the same formula since the last call. */
+static void
+import_ces (BtorGroundSolvers *gslv)
+{
+  BtorQuantSharedCe *head, *cur;
+  BtorBitVectorTuple *ce, *evar_tup;
+  BtorNode *res;
+  BtorMemMgr *mm;
+
+  if (!gslv->shared_ces) return;
+
+  mm   = gslv->forall->mm;
+  head = __atomic_load_n (gslv->shared_ces, __ATOMIC_ACQUIRE);
+  for (cur = head; cur != gslv->shared_ces_seen; cur = cur->next)
+  {
+    if (cur->worker == gslv->id) continue;
+    if (!is_compatible_ce (gslv, cur)) continue;
+    if (btor_hashptr_table_get (gslv->forall_ces, cur->ce)) continue;
+
+    /* the refinement may simplify to true due to different rewriting */
+    res = mk_refinement (gslv, cur->ce);
+    if (res != gslv->exists->true_exp)
+    {
+      ce       = btor_bv_copy_tuple (mm, cur->ce);
+      evar_tup = cur->evars ? btor_bv_copy_tuple (mm, cur->evars) : 0;
+      btor_hashptr_table_add (gslv->forall_ces, ce)->data.as_ptr = evar_tup;
+      btor_assert_exp (gslv->exists, res);
+      gslv->statistics.stats.imported_refinements++;
+    }
+    btor_node_release (gslv->exists, res);
+  }
+  gslv->shared_ces_seen = head;
+}
+
+static void
+delete_shared_ces (BtorQuantSharedCe *shared)
+{
+  BtorQuantSharedCe *next;
+
+  for (; shared; shared = next)
+  {
+    next = shared->next;
+    btor_bv_free_tuple (shared->mm, shared->ce);
+    if (shared->evars) btor_bv_free_tuple (shared->mm, shared->evars);
+    BTOR_DELETE (shared->mm, shared);
+  }
+}
+#endif
+
+static void
+refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
+{
+  assert (gslv->forall_uvars->table->count > 0);
+
+  uint32_t i;
+  Btor *f_solver, *e_solver;
+  BtorNodeMapIterator it;
+  BtorNode *var_fs, *res, *evar;
+  const BtorBitVector *bv;
+  BtorBitVectorTuple *ce, *evar_tup;
+
+  f_solver = gslv->forall;
+  e_solver = gslv->exists;
+
+  /* generate counter example for universal vars */
+  assert (f_solver->last_sat_result == BTOR_RESULT_SAT);
+  f_solver->slv->api.generate_model (f_solver->slv, false, false);
+
+  i  = 0;
+  ce = btor_bv_new_tuple (f_solver->mm, gslv->forall_uvars->table->count);
+  btor_iter_nodemap_init (&it, gslv->forall_uvars);
+  while (btor_iter_nodemap_has_next (&it))
+  {
+    var_fs = it.it.bucket->data.as_ptr;
+    (void) btor_iter_nodemap_next (&it);
+    bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
+    btor_bv_add_to_tuple (f_solver->mm, ce, bv, i++);
+  }
+
+  i        = 0;
+  evar_tup = 0;
+  if (gslv->forall_evars->table->count)
+  {
+    evar_tup =
+        btor_bv_new_tuple (f_solver->mm, gslv->forall_evars->table->count);
+    btor_iter_nodemap_init (&it, gslv->forall_evars);
+    while (btor_iter_nodemap_has_next (&it))
+    {
+      evar   = btor_iter_nodemap_next (&it);
+      var_fs = btor_nodemap_mapped (evar_map, evar);
+      assert (var_fs);
+      bv = btor_model_get_bv (f_solver, btor_simplify_exp (f_solver, var_fs));
+      btor_bv_add_to_tuple (f_solver->mm, evar_tup, bv, i++);
+    }
+  }
+
+  res = mk_refinement (gslv, ce);
 
   assert (res != e_solver->true_exp);
   BTOR_ABORT (res == e_solver->true_exp,
@@ -1063,6 +1222,10 @@ refine_exists_solver (BtorGroundSolvers *gslv, BtorNodeMap *evar_map)
 
   btor_assert_exp (e_solver, res);
   btor_node_release (e_solver, res);
+
+#ifdef BTOR_HAVE_PTHREADS
+  export_ce (gslv, ce, evar_tup);
+#endif
 }
 
 BtorNode *
@@ -1326,6 +1489,9 @@ delete_quant_solver (BtorQuantSolver *slv)
   btor = slv->btor;
   delete_ground_solvers (slv, slv->gslv);
   if (slv->dgslv) delete_ground_solvers (slv, slv->dgslv);
+  while (!BTOR_EMPTY_STACK (slv->workers))
+    delete_ground_solvers (slv, BTOR_POP_STACK (slv->workers));
+  BTOR_RELEASE_STACK (slv->workers);
   BTOR_DELETE (btor->mm, slv);
   btor->slv = 0;
 }
@@ -2396,6 +2562,10 @@ find_model (BtorGroundSolvers *gslv, bool skip_exists)
    * is correct. */
   if (!skip_exists)
   {
+#ifdef BTOR_HAVE_PTHREADS
+    import_ces (gslv);
+#endif
+
     /* query exists solver */
     start = time_stamp ();
     r     = btor_check_sat (gslv->exists, -1, -1);
@@ -2524,56 +2694,102 @@ thread_terminate (void *state)
   return found_result;
 }
 
-static BtorSolverResult
-run_parallel (BtorGroundSolvers *gslv, BtorGroundSolvers *dgslv)
+/* Run 'num_workers' workers in parallel until the first one found a result,
+ * returns the first worker (in order) with a result. */
+static BtorGroundSolvers *
+run_parallel (BtorGroundSolvers **workers, uint32_t num_workers)
 {
+  uint32_t i;
   bool thread_found_result;
   pthread_mutex_t thread_result_mutex = PTHREAD_MUTEX_INITIALIZER;
-  BtorSolverResult res;
-  pthread_t thread_orig, thread_dual;
+  BtorQuantSharedCe *shared_ces[2] = {0, 0};
+  BtorGroundSolvers *gslv, *res;
+  pthread_t *threads;
+  BtorMemMgr *mm;
 
+  mm                    = workers[0]->forall->mm;
   thread_found_result   = false;
   g_measure_thread_time = true;
-  btor_set_term (gslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (gslv->exists, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->forall, thread_terminate, &thread_found_result);
-  btor_set_term (dgslv->exists, thread_terminate, &thread_found_result);
+  BTOR_NEWN (mm, threads, num_workers);
 
-  gslv->found_result        = &thread_found_result;
-  gslv->found_result_mutex  = &thread_result_mutex;
-  dgslv->found_result       = &thread_found_result;
-  dgslv->found_result_mutex = &thread_result_mutex;
+  for (i = 0; i < num_workers; i++)
+  {
+    gslv = workers[i];
+    btor_set_term (gslv->forall, thread_terminate, &thread_found_result);
+    btor_set_term (gslv->exists, thread_terminate, &thread_found_result);
+    gslv->found_result       = &thread_found_result;
+    gslv->found_result_mutex = &thread_result_mutex;
+    /* share counterexamples if more than one worker solves a formula */
+    if (num_workers > 2) gslv->shared_ces = &shared_ces[gslv->dual];
+  }
 
-  pthread_create (&thread_orig, 0, thread_work, gslv);
-  pthread_create (&thread_dual, 0, thread_work, dgslv);
-  pthread_join (thread_orig, 0);
-  pthread_join (thread_dual, 0);
+  for (i = 0; i < num_workers; i++)
+    pthread_create (&threads[i], 0, thread_work, workers[i]);
+  for (i = 0; i < num_workers; i++) pthread_join (threads[i], 0);
 
-  if (gslv->result != BTOR_RESULT_UNKNOWN)
+  res = 0;
+  for (i = 0; i < num_workers; i++)
   {
-    res = gslv->result;
+    gslv = workers[i];
+    gslv->shared_ces = 0;
+    if (!res && gslv->result != BTOR_RESULT_UNKNOWN) res = gslv;
   }
-  else
+  assert (res);
+  delete_shared_ces (shared_ces[0]);
+  delete_shared_ces (shared_ces[1]);
+  BTOR_DELETEN (mm, threads, num_workers);
+
+  if (res->dual)
   {
-    assert (dgslv->result != BTOR_RESULT_UNKNOWN);
-    if (dgslv->result == BTOR_RESULT_SAT)
-    {
-      BTOR_MSG (dgslv->forall->msg,
-                1,
-                "dual solver result: sat, original formula: unsat");
-      res = BTOR_RESULT_UNSAT;
-    }
-    else
-    {
-      assert (dgslv->result == BTOR_RESULT_UNSAT);
-      res = BTOR_RESULT_SAT;
-      BTOR_MSG (dgslv->forall->msg,
-                1,
-                "dual solver result: unsat, original formula: sat");
-    }
+    BTOR_MSG (res->forall->msg,
+              1,
+              "dual solver result: %s, original formula: %s",
+              res->result == BTOR_RESULT_SAT ? "sat" : "unsat",
+              res->result == BTOR_RESULT_SAT ? "unsat" : "sat");
   }
   return res;
 }
+
+/* Vary synthesis settings and seed of an additional worker. */
+static void
+configure_worker (BtorGroundSolvers *gslv, uint32_t variant, uint32_t seed)
+{
+  uint32_t i, synth, synth_qi, limit;
+  Btor *btors[2];
+
+  btors[0] = gslv->forall;
+  btors[1] = gslv->exists;
+
+  synth = btor_opt_get (gslv->forall, BTOR_OPT_QUANT_SYNTH);
+  synth = BTOR_QUANT_SYNTH_MIN
+          + (synth - BTOR_QUANT_SYNTH_MIN + variant)
+                % (BTOR_QUANT_SYNTH_MAX - BTOR_QUANT_SYNTH_MIN + 1);
+  synth_qi = btor_opt_get (gslv->forall, BTOR_OPT_QUANT_SYNTH_QI);
+  if (variant & 1) synth_qi = !synth_qi;
+  limit = btor_opt_get (gslv->forall, BTOR_OPT_QUANT_SYNTH_LIMIT);
+  if (variant % 3 == 1)
+    limit = limit < 10 ? 1 : limit / 10;
+  else if (variant % 3 == 2)
+    limit = limit > UINT32_MAX / 10 ? UINT32_MAX : limit * 10;
+
+  for (i = 0; i < 2; i++)
+  {
+    btor_opt_set (btors[i], BTOR_OPT_QUANT_SYNTH, synth);
+    btor_opt_set (btors[i], BTOR_OPT_QUANT_SYNTH_QI, synth_qi);
+    btor_opt_set (btors[i], BTOR_OPT_QUANT_SYNTH_LIMIT, limit);
+    btor_opt_set (btors[i], BTOR_OPT_SEED, seed);
+  }
+  BTOR_MSG (gslv->forall->msg,
+            1,
+            "worker %u: %s formula, synth %u, synth-qi %u, synth-limit %u, "
+            "seed %u",
+            gslv->id,
+            gslv->dual ? "dual" : "original",
+            synth,
+            synth_qi,
+            limit,
+            seed);
+}
 #endif
 
 static BtorNode *
@@ -2622,24 +2838,94 @@ sat_quant_solver (BtorQuantSolver *slv)
   g = simplify (slv->btor, g);
 
   slv->gslv = setup_solvers (slv, g, false, "forall", "exists");
-  btor_node_release (slv->btor, g);
 
 #ifdef BTOR_HAVE_PTHREADS
-  bool opt_dual_solver;
+  bool opt_dual_solver, dual;
+  uint32_t i, num_workers, opt_seed;
+  char prefix_forall[32], prefix_exists[32];
+  BtorGroundSolvers *gslv, **w;
+  BtorGroundSolversPtrStack workers;
+
   opt_dual_solver = btor_opt_get (slv->btor, BTOR_OPT_QUANT_DUAL_SOLVER) == 1;
+  num_workers     = btor_opt_get (slv->btor, BTOR_OPT_QUANT_WORKERS);
+  opt_seed        = btor_opt_get (slv->btor, BTOR_OPT_SEED);
 
   /* disable dual solver if UFs are present in the formula */
-  if (slv->gslv->exists_ufs->table->count > 0) opt_dual_solver = false;
+  if (slv->gslv->exists_ufs->table->count > 0)
+  {
+    opt_dual_solver = false;
+    num_workers     = 0;
+  }
 
-  if (opt_dual_solver)
+  if (opt_dual_solver || num_workers > 0)
   {
-    slv->dgslv = setup_solvers (
-        slv, slv->gslv->forall_formula, true, "dual_forall", "dual_exists");
-    res = run_parallel (slv->gslv, slv->dgslv);
+    BTOR_INIT_STACK (slv->btor->mm, workers);
+    BTOR_PUSH_STACK (workers, slv->gslv);
+    if (opt_dual_solver)
+    {
+      slv->dgslv = setup_solvers (
+          slv, slv->gslv->forall_formula, true, "dual_forall", "dual_exists");
+      slv->dgslv->id   = 1;
+      slv->dgslv->dual = true;
+      BTOR_PUSH_STACK (workers, slv->dgslv);
+    }
+
+    /* additional workers alternate between the original and the dual
+     * formula (if enabled) */
+    for (i = 0; i < num_workers; i++)
+    {
+      dual = opt_dual_solver && i % 2 == 1;
+      sprintf (prefix_forall, "forall%u", BTOR_COUNT_STACK (workers));
+      sprintf (prefix_exists, "exists%u", BTOR_COUNT_STACK (workers));
+      if (dual)
+        gslv = setup_solvers (slv,
+                              slv->gslv->forall_formula,
+                              true,
+                              prefix_forall,
+                              prefix_exists);
+      else
+        gslv =
+            setup_solvers (slv, g, false, prefix_forall, prefix_exists);
+      gslv->id   = BTOR_COUNT_STACK (workers);
+      gslv->dual = dual;
+      configure_worker (gslv,
+                        opt_dual_solver ? i / 2 + 1 : i + 1,
+                        opt_seed + gslv->id);
+      BTOR_PUSH_STACK (workers, gslv);
+      BTOR_PUSH_STACK (slv->workers, gslv);
+    }
+    btor_node_release (slv->btor, g);
+
+    gslv = run_parallel (workers.start, BTOR_COUNT_STACK (workers));
+
+    /* the winner provides results, statistics and model */
+    if (gslv->dual && gslv != slv->dgslv)
+    {
+      for (w = slv->workers.start; *w != gslv; w++)
+        ;
+      *w         = slv->dgslv;
+      slv->dgslv = gslv;
+    }
+    else if (!gslv->dual && gslv != slv->gslv)
+    {
+      for (w = slv->workers.start; *w != gslv; w++)
+        ;
+      *w        = slv->gslv;
+      slv->gslv = gslv;
+    }
+    BTOR_RELEASE_STACK (workers);
+
+    if (!gslv->dual)
+      res = gslv->result;
+    else if (gslv->result == BTOR_RESULT_SAT)
+      res = BTOR_RESULT_UNSAT;
+    else
+      res = BTOR_RESULT_SAT;
   }
   else
 #endif
   {
+    btor_node_release (slv->btor, g);
     while (true)
     {
       res = find_model (slv->gslv, skip_exists);
@@ -2854,6 +3140,7 @@ btor_new_quantifier_solver (Btor *btor)
   BtorQuantSolver *slv;
 
   BTOR_CNEW (btor->mm, slv);
+  BTOR_INIT_STACK (btor->mm, slv->workers);
 
   slv->kind      = BTOR_QUANT_SOLVER_KIND;
   slv->btor      = btor;
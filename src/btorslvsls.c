@@ -346,6 +346,7 @@ try_move (Btor *btor,
 #endif
 
   btor_lsutils_update_cone (btor,
+                            slv->index,
                             bv_model,
                             slv->roots,
                             score,
@@ -423,6 +424,349 @@ cmp_sls_moves_qsort (const void *move1, const void *move2)
     }                                                                          \
   } while (0)
 
+/*------------------------------------------------------------------------*/
+/* Bit-parallel neighborhood exploration                                  */
+/*------------------------------------------------------------------------*/
+
+/* Instead of trying the neighbors of the current assignment one at a time
+ * (try_move), the assignments of all nodes in the cone of the candidates are
+ * computed for up to BTOR_SLS_MAX_LANES neighbors (lanes) in one sweep over
+ * the cone, with one 64-bit word per node and lane.  This requires that all
+ * nodes in the cone are at most 64 bits wide and can be evaluated on words,
+ * else the neighbors are tried one at a time. */
+
+#define BTOR_SLS_MAX_LANES 64
+
+#define BTOR_SLS_LANE_MASK(bw) \
+  ((bw) >= 64 ? UINT64_MAX : ((uint64_t) 1 << (bw)) - 1)
+
+static bool
+is_lanes_node (Btor *btor, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t i;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+    case BTOR_BV_MUL_NODE:
+    case BTOR_BV_UDIV_NODE:
+    case BTOR_BV_UREM_NODE:
+    case BTOR_BV_CONCAT_NODE:
+    case BTOR_BV_SLICE_NODE: break;
+    case BTOR_COND_NODE:
+      if (btor_node_is_bv_cond (exp)) break;
+      return false;
+    default: return false;
+  }
+  if (btor_node_bv_get_width (btor, exp) > 64) return false;
+  for (i = 0; i < exp->arity; i++)
+    if (btor_node_bv_get_width (btor, exp->e[i]) > 64) return false;
+  return true;
+}
+
+/* Collect the cone of 'candidates' in topological order.  Returns false if
+ * the neighbors of the candidates can not be tried bit-parallel. */
+static bool
+get_lanes_cone (Btor *btor,
+                BtorNodePtrStack *candidates,
+                BtorNodePtrStack *cone)
+{
+  uint32_t i;
+  BtorSLSSolver *slv;
+
+  slv = BTOR_SLS_SOLVER (btor);
+
+  if (!btor_opt_get (btor, BTOR_OPT_SLS_MOVE_LANES)
+      || btor_opt_get (btor, BTOR_OPT_SLS_MOVE_INC_MOVE_TEST))
+    return false;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*candidates); i++)
+    if (btor_node_bv_get_width (btor, BTOR_PEEK_STACK (*candidates, i)) > 64)
+      return false;
+
+  btor_lsutils_index_get_cone (slv->index,
+                               candidates->start,
+                               BTOR_COUNT_STACK (*candidates),
+                               cone);
+  for (i = 0; i < BTOR_COUNT_STACK (*cone); i++)
+    if (!is_lanes_node (btor, BTOR_PEEK_STACK (*cone, i))) return false;
+  return true;
+}
+
+/* Get the assignments of 'exp' in all lanes. */
+static void
+get_lanes_assignment (Btor *btor,
+                      BtorIntHashTable *slots,
+                      uint64_t *ass,
+                      uint32_t nlanes,
+                      BtorNode *exp,
+                      uint64_t *res)
+{
+  uint32_t l;
+  uint64_t a, mask, *slot;
+  BtorNode *real_exp;
+  BtorHashTableData *d;
+
+  real_exp = btor_node_real_addr (exp);
+  d        = btor_hashint_map_get (slots, real_exp->id);
+  if (d)
+  {
+    slot = ass + (size_t) d->as_int * nlanes;
+    mask = btor_node_is_inverted (exp)
+               ? BTOR_SLS_LANE_MASK (btor_node_bv_get_width (btor, real_exp))
+               : 0;
+    for (l = 0; l < nlanes; l++) res[l] = slot[l] ^ mask;
+  }
+  else
+  {
+    a = btor_bv_to_uint64 (btor_model_get_bv (btor, exp));
+    for (l = 0; l < nlanes; l++) res[l] = a;
+  }
+}
+
+/* Get the score of 'exp' in lane 'l'. */
+static double
+get_lanes_score (BtorSLSSolver *slv,
+                 BtorIntHashTable *slots,
+                 double *score,
+                 uint32_t nlanes,
+                 BtorNode *exp,
+                 uint32_t l)
+{
+  BtorNode *real_exp;
+  BtorHashTableData *d;
+
+  real_exp = btor_node_real_addr (exp);
+  d        = btor_hashint_map_get (slots, real_exp->id);
+  if (d && btor_hashint_map_contains (slv->score, real_exp->id))
+    return score[(2 * (size_t) d->as_int + btor_node_is_inverted (exp))
+                     * nlanes
+                 + l];
+  assert (btor_hashint_map_contains (slv->score, btor_node_get_id (exp)));
+  return btor_hashint_map_get (slv->score, btor_node_get_id (exp))->as_dbl;
+}
+
+/* Compute the score of the formula (as compute_sls_score_formula) for each
+ * lane 'l', where each candidate is assigned its neighbor in 'lanes[l]'. */
+static void
+compute_sls_score_formula_lanes (Btor *btor,
+                                 BtorNodePtrStack *candidates,
+                                 BtorNodePtrStack *cone,
+                                 BtorIntHashTable **lanes,
+                                 uint32_t nlanes,
+                                 double *res,
+                                 bool *done)
+{
+  assert (nlanes > 0 && nlanes <= BTOR_SLS_MAX_LANES);
+
+  uint32_t i, j, l, n, ncans, bw, w1, lower;
+  int32_t id;
+  uint64_t mask, a0, a1, *ass, *a, e[3][BTOR_SLS_MAX_LANES];
+  double *score, weight, sc, s0, s1;
+  BtorNode *cur;
+  BtorSLSSolver *slv;
+  BtorIntHashTable *slots;
+  BtorHashTableData *d;
+  BtorIntHashTableIterator it;
+  BtorMemMgr *mm;
+
+  slv   = BTOR_SLS_SOLVER (btor);
+  mm    = btor->mm;
+  ncans = BTOR_COUNT_STACK (*candidates);
+  n     = ncans + BTOR_COUNT_STACK (*cone);
+
+  /* slot i holds the assignments of the i-th node in all lanes, and its
+   * scores (positive and negative) in all lanes */
+  slots = btor_hashint_map_new (mm);
+  BTOR_NEWN (mm, ass, (size_t) n * nlanes);
+  BTOR_NEWN (mm, score, 2 * (size_t) n * nlanes);
+
+  for (i = 0; i < n; i++)
+  {
+    cur = i < ncans ? BTOR_PEEK_STACK (*candidates, i)
+                    : BTOR_PEEK_STACK (*cone, i - ncans);
+    assert (btor_node_is_regular (cur));
+    btor_hashint_map_add (slots, cur->id)->as_int = i;
+    a    = ass + (size_t) i * nlanes;
+    bw   = btor_node_bv_get_width (btor, cur);
+    mask = BTOR_SLS_LANE_MASK (bw);
+
+    if (i < ncans)
+    {
+      for (l = 0; l < nlanes; l++)
+        a[l] = btor_bv_to_uint64 (
+            btor_hashint_map_get (lanes[l], cur->id)->as_ptr);
+    }
+    else
+    {
+      for (j = 0; j < cur->arity; j++)
+        get_lanes_assignment (btor, slots, ass, nlanes, cur->e[j], e[j]);
+
+      switch (cur->kind)
+      {
+        case BTOR_BV_ADD_NODE:
+          for (l = 0; l < nlanes; l++) a[l] = (e[0][l] + e[1][l]) & mask;
+          break;
+        case BTOR_BV_AND_NODE:
+          for (l = 0; l < nlanes; l++) a[l] = e[0][l] & e[1][l];
+          break;
+        case BTOR_BV_EQ_NODE:
+          for (l = 0; l < nlanes; l++) a[l] = e[0][l] == e[1][l];
+          break;
+        case BTOR_BV_ULT_NODE:
+          for (l = 0; l < nlanes; l++) a[l] = e[0][l] < e[1][l];
+          break;
+        case BTOR_BV_SLL_NODE:
+          for (l = 0; l < nlanes; l++)
+            a[l] = e[1][l] < bw ? (e[0][l] << e[1][l]) & mask : 0;
+          break;
+        case BTOR_BV_SRL_NODE:
+          for (l = 0; l < nlanes; l++)
+            a[l] = e[1][l] < bw ? e[0][l] >> e[1][l] : 0;
+          break;
+        case BTOR_BV_MUL_NODE:
+          for (l = 0; l < nlanes; l++) a[l] = (e[0][l] * e[1][l]) & mask;
+          break;
+        case BTOR_BV_UDIV_NODE:
+          for (l = 0; l < nlanes; l++)
+            a[l] = e[1][l] ? e[0][l] / e[1][l] : mask;
+          break;
+        case BTOR_BV_UREM_NODE:
+          for (l = 0; l < nlanes; l++)
+            a[l] = e[1][l] ? e[0][l] % e[1][l] : e[0][l];
+          break;
+        case BTOR_BV_CONCAT_NODE:
+          w1 = btor_node_bv_get_width (btor, cur->e[1]);
+          for (l = 0; l < nlanes; l++) a[l] = (e[0][l] << w1) | e[1][l];
+          break;
+        case BTOR_BV_SLICE_NODE:
+          lower = btor_node_bv_slice_get_lower (cur);
+          for (l = 0; l < nlanes; l++) a[l] = (e[0][l] >> lower) & mask;
+          break;
+        default:
+          assert (btor_node_is_bv_cond (cur));
+          for (l = 0; l < nlanes; l++) a[l] = e[0][l] ? e[1][l] : e[2][l];
+      }
+    }
+
+    /* nodes not reachable from the roots have no score */
+    if (bw != 1 || !btor_hashint_map_contains (slv->score, cur->id)) continue;
+
+    for (l = 0; l < nlanes; l++)
+    {
+      a0 = cur->arity > 0 ? e[0][l] : 0;
+      a1 = cur->arity > 1 ? e[1][l] : 0;
+      s0 = s1 = 0.0;
+      if (btor_node_is_bv_and (cur))
+      {
+        s0 = get_lanes_score (slv, slots, score, nlanes, cur->e[0], l);
+        s1 = get_lanes_score (slv, slots, score, nlanes, cur->e[1], l);
+      }
+      score[2 * (size_t) i * nlanes + l] =
+          btor_slsutils_compute_score_node_uint64 (
+              btor, cur, a[l], a0, a1, s0, s1);
+      if (btor_node_is_bv_and (cur))
+      {
+        s0 = get_lanes_score (
+            slv, slots, score, nlanes, btor_node_invert (cur->e[0]), l);
+        s1 = get_lanes_score (
+            slv, slots, score, nlanes, btor_node_invert (cur->e[1]), l);
+      }
+      score[(2 * (size_t) i + 1) * nlanes + l] =
+          btor_slsutils_compute_score_node_uint64 (
+              btor, btor_node_invert (cur), a[l] ^ 1, a0, a1, s0, s1);
+    }
+  }
+
+  for (l = 0; l < nlanes; l++)
+  {
+    res[l]  = 0.0;
+    done[l] = true;
+  }
+  btor_iter_hashint_init (&it, slv->weights);
+  while (btor_iter_hashint_has_next (&it))
+  {
+    weight =
+        (double) ((BtorSLSConstrData *) slv->weights->data[it.cur_pos].as_ptr)
+            ->weight;
+    id = btor_iter_hashint_next (&it);
+    d  = btor_hashint_map_get (slots, abs (id));
+    for (l = 0; l < nlanes; l++)
+    {
+      if (d)
+        sc = score[(2 * (size_t) d->as_int + (id < 0)) * nlanes + l];
+      else
+        sc = btor_hashint_map_get (slv->score, id)->as_dbl;
+      assert (sc >= 0.0 && sc <= 1.0);
+      if (sc < 1.0) done[l] = false;
+      res[l] += weight * sc;
+    }
+  }
+
+  btor_hashint_map_delete (slots);
+  BTOR_DELETEN (mm, ass, (size_t) n * nlanes);
+  BTOR_DELETEN (mm, score, 2 * (size_t) n * nlanes);
+}
+
+/* Try the neighbors in 'lanes' bit-parallel and select the best move as
+ * the sequential move selection would do.  Takes ownership of 'lanes'. */
+static bool
+select_move_lanes (Btor *btor,
+                   BtorNodePtrStack *candidates,
+                   BtorNodePtrStack *cone,
+                   BtorIntHashTable **lanes,
+                   uint32_t nlanes,
+                   BtorSLSMoveKind mk,
+                   int32_t gw)
+{
+  uint32_t l, sls_strat;
+  bool done, dones[BTOR_SLS_MAX_LANES];
+  double sc, scores[BTOR_SLS_MAX_LANES];
+  BtorSLSMove *m;
+  BtorIntHashTable *cans;
+  BtorIntHashTableIterator iit;
+  BtorSLSSolver *slv;
+
+  done      = false;
+  slv       = BTOR_SLS_SOLVER (btor);
+  sls_strat = btor_opt_get (btor, BTOR_OPT_SLS_STRATEGY);
+
+  compute_sls_score_formula_lanes (
+      btor, candidates, cone, lanes, nlanes, scores, dones);
+
+  for (l = 0; l < nlanes; l++)
+  {
+    cans     = lanes[l];
+    lanes[l] = 0;
+    if (slv->nflips && slv->stats.flips >= slv->nflips)
+    {
+      slv->terminate = true;
+      BTOR_SLS_DELETE_CANS (cans);
+      goto DONE;
+    }
+    slv->stats.flips += 1;
+    slv->stats.lanes += 1;
+    done = dones[l];
+    sc   = scores[l];
+    BTOR_SLS_SELECT_MOVE_CHECK_SCORE (sc);
+  }
+
+DONE:
+  for (l = 0; l < nlanes; l++)
+  {
+    if (!(cans = lanes[l])) continue;
+    BTOR_SLS_DELETE_CANS (cans);
+  }
+  return done;
+}
+
 static inline bool
 select_inc_dec_not_move (Btor *btor,
                          BtorBitVector *(*fun) (BtorMemMgr *,
@@ -440,6 +784,7 @@ select_inc_dec_not_move (Btor *btor,
   BtorNode *can;
   BtorIntHashTable *cans, *bv_model, *score;
   BtorIntHashTableIterator iit;
+  BtorNodePtrStack cone;
   BtorSLSSolver *slv;
 
   done      = false;
@@ -456,10 +801,6 @@ select_inc_dec_not_move (Btor *btor,
     mk = BTOR_SLS_MOVE_NOT;
   }
 
-  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
-  score =
-      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
-
   cans = btor_hashint_map_new (btor->mm);
 
   for (i = 0; i < BTOR_COUNT_STACK (*candidates); i++)
@@ -481,6 +822,19 @@ select_inc_dec_not_move (Btor *btor,
             : fun (btor->mm, ass);
   }
 
+  BTOR_INIT_STACK (btor->mm, cone);
+  if (get_lanes_cone (btor, candidates, &cone))
+  {
+    done = select_move_lanes (btor, candidates, &cone, &cans, 1, mk, gw);
+    BTOR_RELEASE_STACK (cone);
+    return done;
+  }
+  BTOR_RELEASE_STACK (cone);
+
+  bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
+  score =
+      btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
+
   sc = try_move (btor, bv_model, score, cans, &done);
   if (slv->terminate)
   {
@@ -499,15 +853,16 @@ static inline bool
 select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 {
   size_t i, n_endpos;
-  uint32_t pos, cpos, sls_strat;
+  uint32_t pos, cpos, sls_strat, nlanes;
   bool done = false;
   double sc;
   BtorSLSMove *m;
   BtorSLSMoveKind mk;
   BtorBitVector *ass, *max_neigh;
   BtorNode *can;
-  BtorIntHashTable *cans, *bv_model, *score;
+  BtorIntHashTable *cans, *bv_model, *score, *lanes[BTOR_SLS_MAX_LANES];
   BtorIntHashTableIterator iit;
+  BtorNodePtrStack cone;
   BtorSLSSolver *slv;
 
   slv       = BTOR_SLS_SOLVER (btor);
@@ -515,6 +870,33 @@ select_flip_move (Btor *btor, BtorNodePtrStack *candidates, int32_t gw)
 
   mk = BTOR_SLS_MOVE_FLIP;
 
+  /* all single bit flips of the candidates, one lane per bit */
+  BTOR_INIT_STACK (btor->mm, cone);
+  if (get_lanes_cone (btor, candidates, &cone))
+  {
+    for (i = 0, nlanes = 0; i < BTOR_COUNT_STACK (*candidates); i++)
+    {
+      can = BTOR_PEEK_STACK (*candidates, i);
+      if (btor_node_bv_get_width (btor, can) > nlanes)
+        nlanes = btor_node_bv_get_width (btor, can);
+    }
+    for (pos = 0; pos < nlanes; pos++)
+    {
+      lanes[pos] = btor_hashint_map_new (btor->mm);
+      for (i = 0; i < BTOR_COUNT_STACK (*candidates); i++)
+      {
+        can = BTOR_PEEK_STACK (*candidates, i);
+        ass = (BtorBitVector *) btor_model_get_bv (btor, can);
+        btor_hashint_map_add (lanes[pos], can->id)->as_ptr =
+            btor_bv_flipped_bit (btor->mm, ass, pos % btor_bv_get_width (ass));
+      }
+    }
+    done = select_move_lanes (btor, candidates, &cone, lanes, nlanes, mk, gw);
+    BTOR_RELEASE_STACK (cone);
+    return done;
+  }
+  BTOR_RELEASE_STACK (cone);
+
   bv_model = btor_model_clone_bv (btor, btor->bv_model, true);
   score =
       btor_hashint_map_clone (btor->mm, slv->score, btor_clone_data_as_dbl, 0);
@@ -1256,6 +1638,7 @@ move (Btor *btor, uint32_t nmoves)
 #endif
 
   btor_lsutils_update_cone (btor,
+                            slv->index,
                             btor->bv_model,
                             slv->roots,
                             slv->score,
@@ -1408,6 +1791,8 @@ clone_sls_solver (Btor *clone, BtorSLSSolver *slv, BtorNodeMap *exp_map)
 
   res->max_cans = btor_hashint_map_clone (
       clone->mm, slv->max_cans, btor_clone_data_as_bv_ptr, 0);
+  res->index     = 0;
+  res->inv_cache = 0;
 
   return res;
 }
@@ -1429,6 +1814,8 @@ delete_sls_solver (BtorSLSSolver *slv)
 
   if (slv->score) btor_hashint_map_delete (slv->score);
   if (slv->roots) btor_hashint_map_delete (slv->roots);
+  if (slv->index) btor_lsutils_index_delete (slv->index);
+  if (slv->inv_cache) btor_proputils_inv_cache_delete (slv->inv_cache);
   if (slv->weights)
   {
     btor_iter_hashint_init (&it, slv->weights);
@@ -1473,6 +1860,7 @@ sat_sls_solver (BtorSLSSolver *slv)
 
   int32_t j, max_steps, id, nmoves;
   uint32_t nprops;
+  bool save_best;
   BtorSolverResult sat_result;
   BtorNode *root;
   BtorSLSConstrData *d;
@@ -1485,6 +1873,8 @@ sat_sls_solver (BtorSLSSolver *slv)
   nmoves      = 0;
   nprops      = btor_opt_get (btor, BTOR_OPT_PROP_NPROPS);
   slv->nflips = btor_opt_get (btor, BTOR_OPT_SLS_NFLIPS);
+  /* the best assignment is used to seed the SAT solver phases */
+  save_best = btor_opt_get (btor, BTOR_OPT_FUN_PRESEED);
 
   if (btor_terminate (btor))
   {
@@ -1540,6 +1930,11 @@ sat_sls_solver (BtorSLSSolver *slv)
 
   if (!slv->score) slv->score = btor_hashint_map_new (btor->mm);
 
+  assert (!slv->index);
+  slv->index = btor_lsutils_index_new (btor);
+  assert (!slv->inv_cache);
+  slv->inv_cache = btor_proputils_inv_cache_new (btor->mm);
+
   for (;;)
   {
     if (btor_terminate (btor))
@@ -1580,6 +1975,9 @@ sat_sls_solver (BtorSLSSolver *slv)
 
     if (!slv->roots->count) goto SAT;
 
+    if (save_best)
+      btor_lsutils_index_save_best (btor, slv->index, slv->roots->count);
+
     for (j = 0, max_steps = BTOR_SLS_MAXSTEPS (slv->stats.restarts + 1);
          !btor_opt_get (btor, BTOR_OPT_SLS_USE_RESTARTS) || j < max_steps;
          j++)
@@ -1596,6 +1994,9 @@ sat_sls_solver (BtorSLSSolver *slv)
       nmoves += 1;
 
       if (!slv->roots->count) goto SAT;
+
+      if (save_best)
+        btor_lsutils_index_save_best (btor, slv->index, slv->roots->count);
     }
 
     /* restart */
@@ -1635,6 +2036,18 @@ DONE:
     btor_hashint_map_delete (slv->score);
     slv->score = 0;
   }
+  if (slv->index)
+  {
+    if (sat_result == BTOR_RESULT_UNKNOWN)
+      btor_lsutils_index_restore_best (btor, slv->index);
+    btor_lsutils_index_delete (slv->index);
+    slv->index = 0;
+  }
+  if (slv->inv_cache)
+  {
+    btor_proputils_inv_cache_delete (slv->inv_cache);
+    slv->inv_cache = 0;
+  }
   return sat_result;
 }
 
@@ -1676,6 +2089,7 @@ print_stats_sls_solver (BtorSLSSolver *slv)
   BTOR_MSG (btor->msg, 1, "sls moves: %d", slv->stats.moves);
   BTOR_MSG (btor->msg, 1, "sls flips: %d", slv->stats.flips);
   BTOR_MSG (btor->msg, 1, "sls propagation steps: %u", slv->stats.props);
+  BTOR_MSG (btor->msg, 1, "sls bit-parallel flips: %d", slv->stats.lanes);
   BTOR_MSG (btor->msg, 1, "");
   BTOR_MSG (btor->msg,
             1,
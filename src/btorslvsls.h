@@ -14,6 +14,7 @@
 #include "btorbv.h"
 #endif
 
+#include "btorlsutils.h"
 #include "btorslv.h"
 #include "utils/btorhashint.h"
 #include "utils/btorstack.h"
@@ -61,6 +62,10 @@ struct BtorSLSSolver
                                 but does not maintain anything */
   BtorIntHashTable *weights; /* also maintains assertion weights */
   BtorIntHashTable *score;   /* sls score */
+  BtorLsIndex *index;        /* valid during sat call only */
+
+  /* inverse value cache for propagation moves, valid during sat call only */
+  struct BtorPropInvCache *inv_cache;
 
   uint32_t nflips; /* limit, disabled if 0 */
   bool terminate;
@@ -90,6 +95,7 @@ struct BtorSLSSolver
     uint32_t moves;
     uint32_t flips;
     uint32_t props;
+    uint32_t lanes; /* flips tried bit-parallel */
     uint32_t move_flip;
     uint32_t move_inc;
     uint32_t move_dec;
@@ -75,6 +75,33 @@ enum BtorOption
   */
   BTOR_OPT_INCREMENTAL_SMT1,
 
+  /*!
+    * **BTOR_OPT_ACTLIT_SCOPES**
+
+      | Enable (``value``: 1) or disable (``value``: 0) activation literals
+        for context levels created via boolector_push.
+      | If enabled, assertions at a context level > 0 are added permanently,
+        guarded by an activation literal of the level, which is retired on
+        boolector_pop.  Only one assumption per context level is needed
+        for each SAT call.
+      | If disabled, assertions at a context level > 0 are assumed on every
+        SAT call.
+  */
+  BTOR_OPT_ACTLIT_SCOPES,
+
+  /*!
+    * **BTOR_OPT_INCREMENTAL_SIMP**
+
+      | Enable (``value``: 1) or disable (``value``: 0) slice elimination,
+        unconstrained optimization and eager beta reduction in incremental
+        mode.
+      | If enabled, unconstrained optimization is restricted to terms that
+        can not be referenced by future assertions or assumptions, i.e.,
+        terms that are not reachable from expressions held by the user,
+        symbols, assumptions or context levels.
+  */
+  BTOR_OPT_INCREMENTAL_SIMP,
+
   /*!
     * **BTOR_OPT_INPUT_FORMAT**
 
@@ -166,6 +193,17 @@ enum BtorOption
   */
   BTOR_OPT_SAT_ENGINE,
 
+  /*!
+    * **BTOR_OPT_SAT_GC**
+
+      | Rebuild the SAT instance from scratch if at least ``value`` percent
+        of its CNF variables encode AIGs that have been deleted since the
+        last rebuild (``value``: 0 disables rebuilding).
+      | This limits the growth of the SAT solver in long-running incremental
+        sessions, at the cost of losing learned clauses.
+  */
+  BTOR_OPT_SAT_GC,
+
   /*!
     * **BTOR_OPT_AUTO_CLEANUP**
 
@@ -238,6 +276,20 @@ enum BtorOption
   */
   BTOR_OPT_REWRITE_LEVEL,
 
+  /*!
+    * **BTOR_OPT_REWRITE_PROFILE**
+
+      | Enable (``value``: 1 or 2) or disable (``value``: 0) profiling of
+        rewrite rules.
+      | For each rewrite rule, the number of applicability checks, the number
+        of successful applications and the resulting change in the number of
+        nodes are recorded. With ``value`` 2, the time spent in each rule is
+        recorded in addition.
+      | The profile is printed with the statistics and can be dumped in JSON
+        format via :c:func:`boolector_print_rewrite_profile`.
+  */
+  BTOR_OPT_REWRITE_PROFILE,
+
   /*!
     * **BTOR_OPT_SKELETON_PREPROC**
 
@@ -254,6 +306,17 @@ enum BtorOption
   */
   BTOR_OPT_ACKERMANN,
 
+  /*!
+    * **BTOR_OPT_ACKERMANN_BUCKETS**
+
+      | Enable (``value``: 1) or disable (``value``: 0) bucketing of function
+        applications w.r.t. fixed bits of their arguments when adding
+        Ackermann constraints (see BTOR_OPT_ACKERMANN).
+      | Constraints are only added for applications within the same bucket,
+        all other applications are checked lazily.
+  */
+  BTOR_OPT_ACKERMANN_BUCKETS,
+
   /*!
     * **BTOR_OPT_BETA_REDUCE**
 
@@ -262,6 +325,18 @@ enum BtorOption
   */
   BTOR_OPT_BETA_REDUCE,
 
+  /*!
+    * **BTOR_OPT_BETA_REDUCE_CACHE**
+
+      | Set the maximum number of full beta reduction results that are kept
+        across calls (keyed by lambda and arguments).
+      | If the limit is reached, stale entries are removed and the cache is
+        cleared if it is still full.
+      | ``value``: 0 disables keeping results between eliminations of
+        applications (results are only reused within one elimination).
+  */
+  BTOR_OPT_BETA_REDUCE_CACHE,
+
   /*!
     * **BTOR_OPT_ELIMINATE_SLICES**
 
@@ -302,6 +377,93 @@ enum BtorOption
   */
   BTOR_OPT_EXTRACT_LAMBDAS,
 
+  /*!
+    * **BTOR_OPT_ABSINT**
+
+      Enable (``value``: 1) or disable (``value``: 0) abstract interpretation
+      of bit-vector terms with fixed bits and unsigned intervals.
+
+      Terms with a known value are replaced by constants, arithmetic terms and
+      comparisons with known most significant bits by narrower operators.
+  */
+  BTOR_OPT_ABSINT,
+
+  /*!
+    * **BTOR_OPT_SIMP_TIME_BUDGET**
+
+      | Set time budget in milliseconds for the optional simplification passes
+        (slice elimination, skeleton preprocessing, unconstrained optimization,
+        lambda extraction and merging, abstract interpretation, adder
+        normalization) of a single simplification call.
+      | Once the budget is exhausted, these passes are skipped for the rest of
+        the call.
+      | Default: 0 (no budget)
+  */
+  BTOR_OPT_SIMP_TIME_BUDGET,
+
+  /*!
+    * **BTOR_OPT_SIMP_PASS_BUDGET**
+
+      | Set time budget in milliseconds per optional simplification pass and
+        simplification call.
+      | A pass that used up its budget is skipped for the rest of the call.
+      | Default: 0 (no budget)
+  */
+  BTOR_OPT_SIMP_PASS_BUDGET,
+
+  /*!
+    * **BTOR_OPT_SIMP_SKIP_UNPRODUCTIVE**
+
+      | Skip optional simplification passes that did not reduce the formula
+        in the last ``value`` runs (in this or previous incremental calls).
+      | A skipped pass is retried after it has been skipped ``value`` times.
+      | Default: 0 (never skip)
+  */
+  BTOR_OPT_SIMP_SKIP_UNPRODUCTIVE,
+
+  /*!
+    * **BTOR_OPT_DECOMPOSE**
+
+      | Split the formula into independent sub-problems (assertions without
+        common variables) and solve each of them in a separate instance.
+      | Value ``value`` > 0 is the number of worker threads (only effective if
+        Boolector was built with pthreads).
+      | Only applied to non-incremental, quantifier-free bit-vector formulas
+        with engine BTOR_ENGINE_FUN.
+      | Default: 0 (disabled)
+  */
+  BTOR_OPT_DECOMPOSE,
+
+  /*!
+    * **BTOR_OPT_BW_REDUCE**
+
+      | Solve the formula with all variables wider than ``value`` restricted
+        to the sign extension of their ``value`` least significant bits
+        first.
+      | Restrictions that occur in the unsat core are relaxed by doubling the
+        width of the variable until the result is conclusive.
+      | Only applied to non-incremental, quantifier-free bit-vector formulas
+        with engine BTOR_ENGINE_FUN.
+      | Default: 0 (disabled)
+  */
+  BTOR_OPT_BW_REDUCE,
+
+  /*!
+    * **BTOR_OPT_LS_PORTFOLIO**
+
+      | Solve the formula with a portfolio of ``value`` worker threads
+        (only effective if Boolector was built with pthreads).
+      | One worker runs engine BTOR_ENGINE_FUN, all others run the local
+        search engines BTOR_ENGINE_PROP, BTOR_ENGINE_SLS and
+        BTOR_ENGINE_AIGPROP with different seeds and restart and bandit
+        configurations.  The first conclusive result terminates all workers.
+      | Only applied to non-incremental, quantifier-free bit-vector formulas
+        with engines BTOR_ENGINE_PROP, BTOR_ENGINE_SLS and
+        BTOR_ENGINE_AIGPROP.
+      | Default: 0 (disabled)
+  */
+  BTOR_OPT_LS_PORTFOLIO,
+
   /*!
     * **BTOR_OPT_NORMALIZE**
 
@@ -340,6 +502,17 @@ enum BtorOption
    */
   BTOR_OPT_FUN_PRESLS,
 
+  /*!
+    * **BTOR_OPT_FUN_PRESEED**
+
+      Enable (``value``: 1) or disable (``value``: 0) seeding the phases of
+      the SAT solver with the best assignment found by the prop or sls engine
+      if preprocessing with BTOR_OPT_FUN_PREPROP or BTOR_OPT_FUN_PRESLS
+      failed to determine satisfiability (e.g., due to BTOR_OPT_PROP_NPROPS
+      or BTOR_OPT_SLS_NFLIPS).
+   */
+  BTOR_OPT_FUN_PRESEED,
+
   /*!
     * **BTOR_OPT_FUN_DUAL_PROP**
 
@@ -409,6 +582,16 @@ enum BtorOption
   */
   BTOR_OPT_FUN_EAGER_LEMMAS,
 
+  /*!
+    * **BTOR_OPT_FUN_KEEP_LEMMAS**
+
+      Enable (``value``: 1) or disable (``value``: 0) keeping lemmas across
+      satisfiability checks if lemmas are added as assumptions (as done by
+      the quantifier engine).  When enabled, lemmas of previous checks are
+      assumed again rather than being regenerated.
+  */
+  BTOR_OPT_FUN_KEEP_LEMMAS,
+
   BTOR_OPT_FUN_STORE_LAMBDAS,
 
   /*!
@@ -576,6 +759,17 @@ enum BtorOption
   */
   BTOR_OPT_SLS_MOVE_INC_MOVE_TEST,
 
+  /*!
+    * **BTOR_OPT_SLS_MOVE_LANES**
+
+      Enable (``value``: 1) or disable (``value``: 0) that during best move
+      selection, the neighbors of bit-flip, increment, decrement and not moves
+      are tried bit-parallel (up to 64 neighbors at once) rather than one at a
+      time, if all nodes in the cone of the candidate variables are at most 64
+      bits wide.
+  */
+  BTOR_OPT_SLS_MOVE_LANES,
+
   /*!
     * **BTOR_OPT_SLS_MOVE_RESTARTS**
 
@@ -837,6 +1031,20 @@ enum BtorOption
    */
   BTOR_OPT_QUANT_MINISCOPE,
 
+  /*!
+    * **BTOR_OPT_QUANT_WORKERS**
+
+      | Run ``value`` additional CEGQI worker threads (only effective if
+        Boolector was built with pthreads).
+      | Each additional worker solves the original or (if enabled) the dual
+        formula with a different configuration of BTOR_OPT_QUANT_SYNTH,
+        BTOR_OPT_QUANT_SYNTH_QI, BTOR_OPT_QUANT_SYNTH_LIMIT and
+        BTOR_OPT_SEED.  Workers on the same formula share their
+        counterexamples.  The first conclusive result terminates all workers.
+      | Default: 0 (disabled)
+   */
+  BTOR_OPT_QUANT_WORKERS,
+
   /* internal options --------------------------------------------------- */
 
   BTOR_OPT_SORT_EXP,
@@ -735,6 +735,11 @@ NEXT:
       PARSE_ARGS0 (tok);
       boolector_print_stats (btor);
     }
+    else if (!strcmp (tok, "print_rewrite_profile"))
+    {
+      PARSE_ARGS0 (tok);
+      boolector_print_rewrite_profile (btor, stdout);
+    }
     else if (!strcmp (tok, "assert"))
     {
       PARSE_ARGS1 (tok, str);
@@ -0,0 +1,910 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorabsint.h"
+
+#include "btorbv.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btorlog.h"
+#include "btorsubst.h"
+#include "utils/btorhashint.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+/* Abstract value of a bit-vector term.  Bit i is fixed to 1 if it is set in
+ * 'lo', and fixed to 0 if it is not set in 'hi'. */
+struct BtorAbsIntValue
+{
+  BtorBitVector *lo;
+  BtorBitVector *hi;
+  BtorBitVector *min; /* unsigned lower bound */
+  BtorBitVector *max; /* unsigned upper bound */
+};
+
+typedef struct BtorAbsIntValue BtorAbsIntValue;
+
+struct BtorAbsInt
+{
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorIntHashTable *values;  /* maps regular node ids to abstract values */
+  BtorIntHashTable *seeds;   /* maps variable ids to abstract values */
+  BtorIntHashTable *blocked; /* constraints the seeds were derived from */
+};
+
+typedef struct BtorAbsInt BtorAbsInt;
+
+/*------------------------------------------------------------------------*/
+
+static BtorAbsIntValue *
+new_value (BtorMemMgr *mm, uint32_t bw)
+{
+  BtorAbsIntValue *res;
+
+  BTOR_NEW (mm, res);
+  res->lo  = btor_bv_new (mm, bw);
+  res->hi  = btor_bv_ones (mm, bw);
+  res->min = btor_bv_new (mm, bw);
+  res->max = btor_bv_ones (mm, bw);
+  return res;
+}
+
+static BtorAbsIntValue *
+new_const_value (BtorMemMgr *mm, const BtorBitVector *bv)
+{
+  BtorAbsIntValue *res;
+
+  BTOR_NEW (mm, res);
+  res->lo  = btor_bv_copy (mm, bv);
+  res->hi  = btor_bv_copy (mm, bv);
+  res->min = btor_bv_copy (mm, bv);
+  res->max = btor_bv_copy (mm, bv);
+  return res;
+}
+
+static BtorAbsIntValue *
+copy_value (BtorMemMgr *mm, const BtorAbsIntValue *v)
+{
+  BtorAbsIntValue *res;
+
+  BTOR_NEW (mm, res);
+  res->lo  = btor_bv_copy (mm, v->lo);
+  res->hi  = btor_bv_copy (mm, v->hi);
+  res->min = btor_bv_copy (mm, v->min);
+  res->max = btor_bv_copy (mm, v->max);
+  return res;
+}
+
+static void
+delete_value (BtorMemMgr *mm, BtorAbsIntValue *v)
+{
+  btor_bv_free (mm, v->lo);
+  btor_bv_free (mm, v->hi);
+  btor_bv_free (mm, v->min);
+  btor_bv_free (mm, v->max);
+  BTOR_DELETE (mm, v);
+}
+
+static void
+delete_values (BtorMemMgr *mm, BtorIntHashTable *values)
+{
+  BtorIntHashTableIterator it;
+
+  btor_iter_hashint_init (&it, values);
+  while (btor_iter_hashint_has_next (&it))
+    delete_value (mm, btor_iter_hashint_next_data (&it)->as_ptr);
+  btor_hashint_map_delete (values);
+}
+
+/* Replace 'bv' with 'new'. */
+static void
+set_bv (BtorMemMgr *mm, BtorBitVector **bv, BtorBitVector *new)
+{
+  btor_bv_free (mm, *bv);
+  *bv = new;
+}
+
+static void
+set_const (BtorMemMgr *mm, BtorAbsIntValue *v, const BtorBitVector *bv)
+{
+  set_bv (mm, &v->lo, btor_bv_copy (mm, bv));
+  set_bv (mm, &v->hi, btor_bv_copy (mm, bv));
+  set_bv (mm, &v->min, btor_bv_copy (mm, bv));
+  set_bv (mm, &v->max, btor_bv_copy (mm, bv));
+}
+
+static void
+set_bool (BtorMemMgr *mm, BtorAbsIntValue *v, bool val)
+{
+  BtorBitVector *bv;
+
+  bv = val ? btor_bv_one (mm, 1) : btor_bv_new (mm, 1);
+  set_const (mm, v, bv);
+  btor_bv_free (mm, bv);
+}
+
+static const BtorBitVector *
+umin (const BtorBitVector *a, const BtorBitVector *b)
+{
+  return btor_bv_compare (a, b) <= 0 ? a : b;
+}
+
+static const BtorBitVector *
+umax (const BtorBitVector *a, const BtorBitVector *b)
+{
+  return btor_bv_compare (a, b) >= 0 ? a : b;
+}
+
+static bool
+is_fixed (const BtorAbsIntValue *v)
+{
+  return btor_bv_compare (v->lo, v->hi) == 0;
+}
+
+/* Returns the number of most significant bits of 'v' that are fixed. */
+static uint32_t
+get_num_fixed_msbs (BtorMemMgr *mm, const BtorAbsIntValue *v)
+{
+  uint32_t res;
+  BtorBitVector *tmp;
+
+  tmp = btor_bv_xor (mm, v->lo, v->hi);
+  res = btor_bv_get_num_leading_zeros (tmp);
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+/* Mask with the 'n' most significant bits set. */
+static BtorBitVector *
+msbs_mask (BtorMemMgr *mm, uint32_t bw, uint32_t n)
+{
+  BtorBitVector *res, *ones;
+
+  if (n == 0) return btor_bv_new (mm, bw);
+  ones = btor_bv_ones (mm, bw);
+  res  = btor_bv_sll_uint64 (mm, ones, bw - n);
+  btor_bv_free (mm, ones);
+  return res;
+}
+
+/* Tighten the bounds of 'v' w.r.t. its fixed bits and fix the most
+ * significant bits the bounds have in common.  Returns false if there is no
+ * value that matches 'v'. */
+static bool
+refine_value (BtorMemMgr *mm, BtorAbsIntValue *v)
+{
+  bool res;
+  uint32_t bw, n;
+  BtorBitVector *tmp, *mask;
+
+  if (btor_bv_compare (v->min, v->lo) < 0)
+    set_bv (mm, &v->min, btor_bv_copy (mm, v->lo));
+  if (btor_bv_compare (v->max, v->hi) > 0)
+    set_bv (mm, &v->max, btor_bv_copy (mm, v->hi));
+  if (btor_bv_compare (v->min, v->max) > 0) return false;
+
+  bw  = btor_bv_get_width (v->min);
+  tmp = btor_bv_xor (mm, v->min, v->max);
+  n   = btor_bv_get_num_leading_zeros (tmp);
+  btor_bv_free (mm, tmp);
+  if (n > 0)
+  {
+    mask = msbs_mask (mm, bw, n);
+    tmp  = btor_bv_and (mm, v->min, mask);
+    set_bv (mm, &v->lo, btor_bv_or (mm, v->lo, tmp));
+    btor_bv_free (mm, tmp);
+    tmp = btor_bv_not (mm, mask);
+    set_bv (mm, &tmp, btor_bv_or (mm, tmp, v->min));
+    set_bv (mm, &v->hi, btor_bv_and (mm, v->hi, tmp));
+    btor_bv_free (mm, tmp);
+    btor_bv_free (mm, mask);
+  }
+
+  /* bits fixed to 0 and 1 at the same time */
+  tmp = btor_bv_not (mm, v->hi);
+  set_bv (mm, &tmp, btor_bv_and (mm, tmp, v->lo));
+  res = btor_bv_is_zero (tmp);
+  btor_bv_free (mm, tmp);
+  if (!res) return false;
+
+  if (btor_bv_compare (v->min, v->lo) < 0)
+    set_bv (mm, &v->min, btor_bv_copy (mm, v->lo));
+  if (btor_bv_compare (v->max, v->hi) > 0)
+    set_bv (mm, &v->max, btor_bv_copy (mm, v->hi));
+  return btor_bv_compare (v->min, v->max) <= 0;
+}
+
+/* Returns a copy of the abstract value of 'exp' w.r.t. its polarity. */
+static BtorAbsIntValue *
+get_value (BtorAbsInt *ai, BtorNode *exp)
+{
+  BtorMemMgr *mm;
+  BtorHashTableData *d;
+  BtorAbsIntValue *v, *res;
+
+  mm = ai->mm;
+  d  = btor_hashint_map_get (ai->values, btor_node_real_addr (exp)->id);
+  assert (d);
+  v = d->as_ptr;
+  if (!btor_node_is_inverted (exp)) return copy_value (mm, v);
+
+  BTOR_NEW (mm, res);
+  res->lo  = btor_bv_not (mm, v->hi);
+  res->hi  = btor_bv_not (mm, v->lo);
+  res->min = btor_bv_not (mm, v->max);
+  res->max = btor_bv_not (mm, v->min);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+compute_add (BtorMemMgr *mm,
+             BtorAbsIntValue *res,
+             BtorAbsIntValue *a,
+             BtorAbsIntValue *b)
+{
+  BtorBitVector *psz, *pso, *ckz, *cko, *known, *tmp;
+
+  /* fixed bits, see LLVM's KnownBits::computeForAddSub */
+  psz = btor_bv_add (mm, a->hi, b->hi);
+  pso = btor_bv_add (mm, a->lo, b->lo);
+  tmp = btor_bv_xor (mm, psz, a->hi);
+  set_bv (mm, &tmp, btor_bv_xor (mm, tmp, b->hi));
+  ckz = btor_bv_not (mm, tmp);
+  btor_bv_free (mm, tmp);
+  cko = btor_bv_xor (mm, pso, a->lo);
+  set_bv (mm, &cko, btor_bv_xor (mm, cko, b->lo));
+
+  known = btor_bv_or (mm, ckz, cko);
+  tmp   = btor_bv_xnor (mm, a->lo, a->hi);
+  set_bv (mm, &known, btor_bv_and (mm, known, tmp));
+  btor_bv_free (mm, tmp);
+  tmp = btor_bv_xnor (mm, b->lo, b->hi);
+  set_bv (mm, &known, btor_bv_and (mm, known, tmp));
+  btor_bv_free (mm, tmp);
+
+  set_bv (mm, &res->lo, btor_bv_and (mm, pso, known));
+  tmp = btor_bv_not (mm, known);
+  set_bv (mm, &res->hi, btor_bv_or (mm, psz, tmp));
+  btor_bv_free (mm, tmp);
+
+  /* bounds, if the sum of the upper bounds does not overflow */
+  tmp = btor_bv_add (mm, a->max, b->max);
+  if (btor_bv_compare (tmp, a->max) >= 0)
+  {
+    set_bv (mm, &res->max, tmp);
+    set_bv (mm, &res->min, btor_bv_add (mm, a->min, b->min));
+  }
+  else
+    btor_bv_free (mm, tmp);
+
+  btor_bv_free (mm, known);
+  btor_bv_free (mm, ckz);
+  btor_bv_free (mm, cko);
+  btor_bv_free (mm, psz);
+  btor_bv_free (mm, pso);
+}
+
+static void
+compute_mul (BtorMemMgr *mm,
+             BtorAbsIntValue *res,
+             BtorAbsIntValue *a,
+             BtorAbsIntValue *b)
+{
+  uint32_t bw, tz;
+  BtorBitVector *mask;
+
+  bw = btor_bv_get_width (res->lo);
+
+  /* the product has at least as many trailing zeros as both factors */
+  tz = btor_bv_get_num_trailing_zeros (a->hi)
+       + btor_bv_get_num_trailing_zeros (b->hi);
+  if (tz >= bw)
+    set_bv (mm, &res->hi, btor_bv_new (mm, bw));
+  else if (tz > 0)
+  {
+    mask = msbs_mask (mm, bw, bw - tz);
+    set_bv (mm, &res->hi, btor_bv_and (mm, res->hi, mask));
+    btor_bv_free (mm, mask);
+  }
+
+  if (!btor_bv_is_umulo (mm, a->max, b->max))
+  {
+    set_bv (mm, &res->min, btor_bv_mul (mm, a->min, b->min));
+    set_bv (mm, &res->max, btor_bv_mul (mm, a->max, b->max));
+  }
+}
+
+static void
+compute_slice (BtorMemMgr *mm,
+               BtorAbsIntValue *res,
+               BtorAbsIntValue *a,
+               uint32_t upper,
+               uint32_t lower)
+{
+  uint32_t bw;
+  bool fits;
+  BtorBitVector *tmp;
+
+  bw = btor_bv_get_width (a->lo);
+  set_bv (mm, &res->lo, btor_bv_slice (mm, a->lo, upper, lower));
+  set_bv (mm, &res->hi, btor_bv_slice (mm, a->hi, upper, lower));
+
+  /* the slice is monotonic if no bit above 'upper' can be set */
+  fits = upper + 1 == bw;
+  if (!fits)
+  {
+    tmp  = btor_bv_slice (mm, a->max, bw - 1, upper + 1);
+    fits = btor_bv_is_zero (tmp);
+    btor_bv_free (mm, tmp);
+  }
+  if (fits)
+  {
+    set_bv (mm, &res->min, btor_bv_slice (mm, a->min, upper, lower));
+    set_bv (mm, &res->max, btor_bv_slice (mm, a->max, upper, lower));
+  }
+}
+
+static void
+compute_eq (BtorMemMgr *mm,
+            BtorAbsIntValue *res,
+            BtorAbsIntValue *a,
+            BtorAbsIntValue *b)
+{
+  bool conflict;
+  BtorBitVector *tmp, *diff;
+
+  if (is_fixed (a) && is_fixed (b))
+  {
+    set_bool (mm, res, btor_bv_compare (a->lo, b->lo) == 0);
+    return;
+  }
+
+  if (btor_bv_compare (a->max, b->min) < 0
+      || btor_bv_compare (b->max, a->min) < 0)
+  {
+    set_bool (mm, res, false);
+    return;
+  }
+
+  /* some bit is fixed to different values */
+  tmp  = btor_bv_not (mm, b->hi);
+  diff = btor_bv_and (mm, a->lo, tmp);
+  btor_bv_free (mm, tmp);
+  tmp = btor_bv_not (mm, a->hi);
+  set_bv (mm, &tmp, btor_bv_and (mm, b->lo, tmp));
+  set_bv (mm, &diff, btor_bv_or (mm, diff, tmp));
+  btor_bv_free (mm, tmp);
+  conflict = !btor_bv_is_zero (diff);
+  btor_bv_free (mm, diff);
+  if (conflict) set_bool (mm, res, false);
+}
+
+/* Least abstract value that covers both 'a' and 'b'. */
+static void
+join_values (BtorMemMgr *mm,
+             BtorAbsIntValue *res,
+             BtorAbsIntValue *a,
+             BtorAbsIntValue *b)
+{
+  set_bv (mm, &res->lo, btor_bv_and (mm, a->lo, b->lo));
+  set_bv (mm, &res->hi, btor_bv_or (mm, a->hi, b->hi));
+  set_bv (mm, &res->min, btor_bv_copy (mm, umin (a->min, b->min)));
+  set_bv (mm, &res->max, btor_bv_copy (mm, umax (a->max, b->max)));
+}
+
+/* Compute the abstract value of the regular bit-vector node 'exp' from the
+ * abstract values of its children. */
+static BtorAbsIntValue *
+compute_value (BtorAbsInt *ai, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t bw;
+  BtorMemMgr *mm;
+  BtorHashTableData *d;
+  BtorBitVector *tmp;
+  BtorAbsIntValue *res, *a = 0, *b = 0, *c = 0, *branch;
+
+  mm = ai->mm;
+  bw = btor_node_bv_get_width (ai->btor, exp);
+
+  if (btor_node_is_bv_const (exp))
+    return new_const_value (mm, btor_node_bv_const_get_bits (exp));
+
+  if (btor_node_is_bv_var (exp))
+  {
+    d = btor_hashint_map_get (ai->seeds, exp->id);
+    return d ? copy_value (mm, d->as_ptr) : new_value (mm, bw);
+  }
+
+  res = new_value (mm, bw);
+  if (exp->parameterized || btor_node_is_apply (exp)) return res;
+
+  switch (exp->kind)
+  {
+    case BTOR_BV_AND_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      set_bv (mm, &res->lo, btor_bv_and (mm, a->lo, b->lo));
+      set_bv (mm, &res->hi, btor_bv_and (mm, a->hi, b->hi));
+      set_bv (mm, &res->max, btor_bv_copy (mm, umin (a->max, b->max)));
+      break;
+
+    case BTOR_BV_CONCAT_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      set_bv (mm, &res->lo, btor_bv_concat (mm, a->lo, b->lo));
+      set_bv (mm, &res->hi, btor_bv_concat (mm, a->hi, b->hi));
+      set_bv (mm, &res->min, btor_bv_concat (mm, a->min, b->min));
+      set_bv (mm, &res->max, btor_bv_concat (mm, a->max, b->max));
+      break;
+
+    case BTOR_BV_SLICE_NODE:
+      a = get_value (ai, exp->e[0]);
+      compute_slice (mm,
+                     res,
+                     a,
+                     btor_node_bv_slice_get_upper (exp),
+                     btor_node_bv_slice_get_lower (exp));
+      break;
+
+    case BTOR_BV_ADD_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      compute_add (mm, res, a, b);
+      break;
+
+    case BTOR_BV_MUL_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      compute_mul (mm, res, a, b);
+      break;
+
+    case BTOR_BV_ULT_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      if (btor_bv_compare (a->max, b->min) < 0)
+        set_bool (mm, res, true);
+      else if (btor_bv_compare (a->min, b->max) >= 0)
+        set_bool (mm, res, false);
+      break;
+
+    case BTOR_BV_EQ_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      compute_eq (mm, res, a, b);
+      break;
+
+    case BTOR_BV_SLL_NODE:
+    case BTOR_BV_SRL_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      if (is_fixed (b))
+      {
+        if (exp->kind == BTOR_BV_SLL_NODE)
+        {
+          set_bv (mm, &res->lo, btor_bv_sll (mm, a->lo, b->lo));
+          set_bv (mm, &res->hi, btor_bv_sll (mm, a->hi, b->lo));
+        }
+        else
+        {
+          set_bv (mm, &res->lo, btor_bv_srl (mm, a->lo, b->lo));
+          set_bv (mm, &res->hi, btor_bv_srl (mm, a->hi, b->lo));
+          set_bv (mm, &res->min, btor_bv_srl (mm, a->min, b->lo));
+          set_bv (mm, &res->max, btor_bv_srl (mm, a->max, b->lo));
+        }
+      }
+      else if (exp->kind == BTOR_BV_SRL_NODE)
+        set_bv (mm, &res->max, btor_bv_copy (mm, a->max));
+      break;
+
+    case BTOR_BV_UDIV_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      /* division by zero yields ~0 */
+      if (!btor_bv_is_zero (b->min))
+      {
+        set_bv (mm, &res->min, btor_bv_udiv (mm, a->min, b->max));
+        set_bv (mm, &res->max, btor_bv_udiv (mm, a->max, b->min));
+      }
+      break;
+
+    case BTOR_BV_UREM_NODE:
+      a = get_value (ai, exp->e[0]);
+      b = get_value (ai, exp->e[1]);
+      /* x % 0 = x, x % y < y otherwise */
+      set_bv (mm, &res->max, btor_bv_copy (mm, a->max));
+      if (!btor_bv_is_zero (b->min))
+      {
+        tmp = btor_bv_dec (mm, b->max);
+        set_bv (mm, &res->max, btor_bv_copy (mm, umin (a->max, tmp)));
+        btor_bv_free (mm, tmp);
+      }
+      break;
+
+    case BTOR_COND_NODE:
+      c = get_value (ai, exp->e[0]);
+      a = get_value (ai, exp->e[1]);
+      b = get_value (ai, exp->e[2]);
+      if (is_fixed (c))
+      {
+        branch = btor_bv_is_true (c->lo) ? a : b;
+        join_values (mm, res, branch, branch);
+      }
+      else
+        join_values (mm, res, a, b);
+      break;
+
+    default: break;
+  }
+
+  if (a) delete_value (mm, a);
+  if (b) delete_value (mm, b);
+  if (c) delete_value (mm, c);
+
+  if (!refine_value (mm, res))
+  {
+    /* 'exp' has no value, i.e., the constraints are unsatisfiable.  We leave
+     * it to the solver to detect that. */
+    delete_value (mm, res);
+    res = new_value (mm, bw);
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+/* Intersect the bounds of 'var' with 'min' and 'max' (if given). */
+static void
+add_seed (BtorAbsInt *ai,
+          BtorNode *var,
+          const BtorBitVector *min,
+          const BtorBitVector *max)
+{
+  BtorMemMgr *mm;
+  BtorHashTableData *d;
+  BtorAbsIntValue *v;
+
+  mm = ai->mm;
+  d  = btor_hashint_map_get (ai->seeds, var->id);
+  if (!d)
+  {
+    d         = btor_hashint_map_add (ai->seeds, var->id);
+    d->as_ptr = new_value (mm, btor_node_bv_get_width (ai->btor, var));
+  }
+  v = d->as_ptr;
+  if (min && btor_bv_compare (min, v->min) > 0)
+    set_bv (mm, &v->min, btor_bv_copy (mm, min));
+  if (max && btor_bv_compare (max, v->max) < 0)
+    set_bv (mm, &v->max, btor_bv_copy (mm, max));
+}
+
+static void
+block (BtorAbsInt *ai, BtorNode *exp)
+{
+  exp = btor_node_real_addr (exp);
+  if (!btor_hashint_table_contains (ai->blocked, exp->id))
+    btor_hashint_table_add (ai->blocked, exp->id);
+}
+
+/* Derive bounds of variables from top level constraints x < c, c < x and
+ * their negations.  These constraints (and the conjunctions they occur in)
+ * must not be substituted since they justify the bounds. */
+static void
+collect_seeds (BtorAbsInt *ai)
+{
+  bool neg;
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorNode *cur, *real, *var, *c;
+  BtorNodePtrStack visit;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTableIterator iit;
+  BtorBitVector *bits, *tmp;
+  BtorAbsIntValue *v;
+  BtorHashTableData *d;
+
+  btor = ai->btor;
+  mm   = ai->mm;
+
+  BTOR_INIT_STACK (mm, visit);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur  = BTOR_POP_STACK (visit);
+    real = btor_node_real_addr (cur);
+
+    if (btor_node_is_regular (cur) && btor_node_is_bv_and (cur))
+    {
+      block (ai, cur);
+      BTOR_PUSH_STACK (visit, cur->e[0]);
+      BTOR_PUSH_STACK (visit, cur->e[1]);
+      continue;
+    }
+
+    if (!btor_node_is_bv_ult (real)) continue;
+
+    neg = btor_node_is_inverted (cur);
+    if (btor_node_is_regular (real->e[0]) && btor_node_is_bv_var (real->e[0])
+        && btor_node_is_bv_const (real->e[1]))
+    {
+      var = real->e[0];
+      c   = real->e[1];
+    }
+    else if (btor_node_is_regular (real->e[1])
+             && btor_node_is_bv_var (real->e[1])
+             && btor_node_is_bv_const (real->e[0]))
+    {
+      var = real->e[1];
+      c   = real->e[0];
+    }
+    else
+      continue;
+
+    bits = btor_node_is_inverted (c)
+               ? btor_node_bv_const_get_invbits (btor_node_real_addr (c))
+               : btor_node_bv_const_get_bits (c);
+
+    if (var == real->e[0])
+    {
+      /* x < c */
+      if (neg)
+        add_seed (ai, var, bits, 0);
+      else if (!btor_bv_is_zero (bits))
+      {
+        tmp = btor_bv_dec (mm, bits);
+        add_seed (ai, var, 0, tmp);
+        btor_bv_free (mm, tmp);
+      }
+    }
+    else
+    {
+      /* c < x */
+      if (neg)
+        add_seed (ai, var, 0, bits);
+      else if (!btor_bv_is_ones (bits))
+      {
+        tmp = btor_bv_inc (mm, bits);
+        add_seed (ai, var, tmp, 0);
+        btor_bv_free (mm, tmp);
+      }
+    }
+    block (ai, real);
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  btor_iter_hashint_init (&iit, ai->seeds);
+  while (btor_iter_hashint_has_next (&iit))
+  {
+    d = btor_iter_hashint_next_data (&iit);
+    v = d->as_ptr;
+    if (refine_value (mm, v)) continue;
+    /* contradicting bounds, left to the solver */
+    d->as_ptr = new_value (mm, btor_bv_get_width (v->lo));
+    delete_value (mm, v);
+  }
+}
+
+/* Compute the abstract values of all bit-vector terms in the cones of the
+ * constraints.  The terms are collected in 'nodes' in post-order.  Function
+ * bodies are not entered. */
+static void
+compute_values (BtorAbsInt *ai, BtorNodePtrStack *nodes)
+{
+  uint32_t i;
+  Btor *btor;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorPtrHashTableIterator it;
+  BtorIntHashTable *mark;
+  BtorHashTableData *d;
+
+  btor = ai->btor;
+  mark = btor_hashint_map_new (ai->mm);
+
+  BTOR_INIT_STACK (ai->mm, visit);
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    d   = btor_hashint_map_get (mark, cur->id);
+    if (!d)
+    {
+      btor_hashint_map_add (mark, cur->id);
+      BTOR_PUSH_STACK (visit, cur);
+      if (btor_node_is_fun (cur) || btor_node_is_quantifier (cur)
+          || cur->parameterized)
+        continue;
+      for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+    }
+    else if (d->as_int == 0)
+    {
+      d->as_int = 1;
+      if (!btor_sort_is_bv (btor, btor_node_get_sort_id (cur))) continue;
+      btor_hashint_map_add (ai->values, cur->id)->as_ptr =
+          compute_value (ai, cur);
+      BTOR_PUSH_STACK (*nodes, cur);
+    }
+  }
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_map_delete (mark);
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorNode *
+mk_binary (Btor *btor, BtorNodeKind kind, BtorNode *e0, BtorNode *e1)
+{
+  switch (kind)
+  {
+    case BTOR_BV_AND_NODE: return btor_exp_bv_and (btor, e0, e1);
+    case BTOR_BV_ADD_NODE: return btor_exp_bv_add (btor, e0, e1);
+    case BTOR_BV_MUL_NODE: return btor_exp_bv_mul (btor, e0, e1);
+    case BTOR_BV_EQ_NODE: return btor_exp_eq (btor, e0, e1);
+    default:
+      assert (kind == BTOR_BV_ULT_NODE);
+      return btor_exp_bv_ult (btor, e0, e1);
+  }
+}
+
+/* Apply the operator of 'exp' to the 'bw' least significant bits of its
+ * children. */
+static BtorNode *
+mk_narrow_binary (Btor *btor, BtorNode *exp, uint32_t bw)
+{
+  BtorNode *e0, *e1, *res;
+
+  e0  = btor_exp_bv_slice (btor, exp->e[0], bw - 1, 0);
+  e1  = btor_exp_bv_slice (btor, exp->e[1], bw - 1, 0);
+  res = mk_binary (btor, exp->kind, e0, e1);
+  btor_node_release (btor, e0);
+  btor_node_release (btor, e1);
+  return res;
+}
+
+/* Returns the substitution of 'exp' w.r.t. its abstract value, or 0.
+ * Operators are only narrowed if at least half of the bits are fixed, which
+ * otherwise does not pay off the additional slices and concats. */
+static BtorNode *
+get_substitution (BtorAbsInt *ai, BtorNode *exp)
+{
+  assert (btor_node_is_regular (exp));
+
+  uint32_t bw, n, na, nb;
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorNode *res, *msbs, *lsbs;
+  BtorBitVector *bits;
+  BtorAbsIntValue *v, *a, *b;
+
+  btor = ai->btor;
+  mm   = ai->mm;
+  v    = btor_hashint_map_get (ai->values, exp->id)->as_ptr;
+  bw   = btor_node_bv_get_width (btor, exp);
+  res  = 0;
+
+  if (is_fixed (v)) return btor_exp_bv_const (btor, v->lo);
+
+  switch (exp->kind)
+  {
+    /* x op y = msbs :: (x[k:0] op y[k:0]) */
+    case BTOR_BV_AND_NODE:
+    case BTOR_BV_ADD_NODE:
+    case BTOR_BV_MUL_NODE:
+      n = get_num_fixed_msbs (mm, v);
+      if (2 * n < bw) break;
+      assert (n < bw);
+      bits = btor_bv_slice (mm, v->lo, bw - 1, bw - n);
+      msbs = btor_exp_bv_const (btor, bits);
+      lsbs = mk_narrow_binary (btor, exp, bw - n);
+      res  = btor_exp_bv_concat (btor, msbs, lsbs);
+      btor_node_release (btor, msbs);
+      btor_node_release (btor, lsbs);
+      btor_bv_free (mm, bits);
+      break;
+
+    /* equal fixed msbs of both operands do not affect the result */
+    case BTOR_BV_EQ_NODE:
+    case BTOR_BV_ULT_NODE:
+      a    = get_value (ai, exp->e[0]);
+      b    = get_value (ai, exp->e[1]);
+      bw   = btor_bv_get_width (a->lo);
+      na   = get_num_fixed_msbs (mm, a);
+      nb   = get_num_fixed_msbs (mm, b);
+      bits = btor_bv_xor (mm, a->lo, b->lo);
+      n    = btor_bv_get_num_leading_zeros (bits);
+      n    = BTOR_MIN_UTIL (n, BTOR_MIN_UTIL (na, nb));
+      if (2 * n >= bw && n < bw) res = mk_narrow_binary (btor, exp, bw - n);
+      btor_bv_free (mm, bits);
+      delete_value (mm, a);
+      delete_value (mm, b);
+      break;
+
+    default: break;
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+void
+btor_absint_simplify (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i, count;
+  double start, delta;
+  BtorAbsInt ai;
+  BtorNode *cur, *subst;
+  BtorNodePtrStack nodes;
+
+  if (btor->quantifiers->count) return;
+  if (btor->unsynthesized_constraints->count == 0
+      && btor->synthesized_constraints->count == 0)
+    return;
+
+  start = btor_util_time_stamp ();
+  count = 0;
+  BTORLOG (1, "start abstract interpretation");
+
+  BTOR_CLR (&ai);
+  ai.btor    = btor;
+  ai.mm      = btor->mm;
+  ai.values  = btor_hashint_map_new (btor->mm);
+  ai.seeds   = btor_hashint_map_new (btor->mm);
+  ai.blocked = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, nodes);
+
+  collect_seeds (&ai);
+  compute_values (&ai, &nodes);
+
+  btor_init_substitutions (btor);
+  for (i = 0; i < BTOR_COUNT_STACK (nodes); i++)
+  {
+    cur = BTOR_PEEK_STACK (nodes, i);
+    if (btor_node_is_bv_const (cur) || btor_node_is_bv_var (cur)
+        || btor_node_is_apply (cur) || cur->parameterized
+        || btor_hashint_table_contains (ai.blocked, cur->id))
+      continue;
+    subst = get_substitution (&ai, cur);
+    if (!subst) continue;
+    if (btor_node_real_addr (subst) != cur)
+    {
+      btor_insert_substitution (btor, cur, subst, false);
+      count++;
+    }
+    btor_node_release (btor, subst);
+  }
+
+  BTOR_RELEASE_STACK (nodes);
+  delete_values (btor->mm, ai.values);
+  delete_values (btor->mm, ai.seeds);
+  btor_hashint_table_delete (ai.blocked);
+
+  if (count) btor_substitute_and_rebuild (btor, btor->substitutions);
+  btor_delete_substitutions (btor);
+
+  btor->stats.absint_substitutions += count;
+  delta = btor_util_time_stamp () - start;
+  BTORLOG (1, "end abstract interpretation");
+  BTOR_MSG (btor->msg,
+            1,
+            "%u abstract interpretation substitutions in %.1f seconds",
+            count,
+            delta);
+}
@@ -0,0 +1,19 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORABSINT_H_INCLUDED
+#define BTORABSINT_H_INCLUDED
+
+#include "btortypes.h"
+
+/* Compute fixed bits and unsigned intervals of all bit-vector terms in the
+ * constraints (forward, seeded with bounds on variables implied by top level
+ * comparisons with constants).  Terms with known value are replaced by
+ * constants, and arithmetic terms and comparisons with fixed most
+ * significant bits are replaced by narrower operators. */
+void btor_absint_simplify (Btor *btor);
+
+#endif
@@ -9,30 +9,325 @@
 
 #include "preprocess/btorack.h"
 
+#include "btorbv.h"
 #include "btorcore.h"
 #include "btorexp.h"
+#include "utils/btorhashint.h"
+#include "utils/btorhashptr.h"
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+/* Bits of a bit-vector term that are fixed to a constant value. */
+struct BtorAckFixedBits
+{
+  BtorBitVector *mask;  /* bit is fixed if set */
+  BtorBitVector *value; /* value of fixed bits, other bits are 0 */
+};
+
+typedef struct BtorAckFixedBits BtorAckFixedBits;
+
+/*------------------------------------------------------------------------*/
+
+static void
+add_ackermann_constraint (Btor *btor, BtorNode *app_i, BtorNode *app_j)
+{
+  BtorNode *p, *c, *imp, *a_i, *a_j, *eq, *tmp;
+  BtorArgsIterator ait_i, ait_j;
+
+  p = 0;
+  assert (btor_node_get_sort_id (app_i->e[1])
+          == btor_node_get_sort_id (app_j->e[1]));
+  btor_iter_args_init (&ait_i, app_i->e[1]);
+  btor_iter_args_init (&ait_j, app_j->e[1]);
+  while (btor_iter_args_has_next (&ait_i))
+  {
+    a_i = btor_iter_args_next (&ait_i);
+    a_j = btor_iter_args_next (&ait_j);
+    eq  = btor_exp_eq (btor, a_i, a_j);
+
+    if (!p)
+      p = eq;
+    else
+    {
+      tmp = p;
+      p   = btor_exp_bv_and (btor, tmp, eq);
+      btor_node_release (btor, tmp);
+      btor_node_release (btor, eq);
+    }
+  }
+  c   = btor_exp_eq (btor, app_i, app_j);
+  imp = btor_exp_implies (btor, p, c);
+  btor->stats.ackermann_constraints++;
+  btor_assert_exp (btor, imp);
+  btor_node_release (btor, p);
+  btor_node_release (btor, c);
+  btor_node_release (btor, imp);
+}
+
+static uint32_t
+add_ackermann_constraints_all (Btor *btor, BtorNodePtrStack *applies)
+{
+  uint32_t i, j, res = 0;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*applies); i++)
+    for (j = i + 1; j < BTOR_COUNT_STACK (*applies); j++)
+    {
+      add_ackermann_constraint (
+          btor, BTOR_PEEK_STACK (*applies, i), BTOR_PEEK_STACK (*applies, j));
+      res++;
+    }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static BtorAckFixedBits *
+get_cached_fixed_bits (BtorIntHashTable *fixed, BtorNode *exp)
+{
+  BtorHashTableData *d;
+  d = btor_hashint_map_get (fixed, btor_node_real_addr (exp)->id);
+  assert (d);
+  assert (d->as_ptr);
+  return d->as_ptr;
+}
+
+/* Get the value of the fixed bits of 'fb' w.r.t. the polarity of the term. */
+static BtorBitVector *
+get_fixed_value (BtorMemMgr *mm, BtorAckFixedBits *fb, bool inverted)
+{
+  BtorBitVector *tmp, *res;
+
+  if (!inverted) return btor_bv_copy (mm, fb->value);
+  tmp = btor_bv_not (mm, fb->value);
+  res = btor_bv_and (mm, tmp, fb->mask);
+  btor_bv_free (mm, tmp);
+  return res;
+}
+
+/* Determine the fixed bits of constants and concatenations of terms with
+ * fixed bits.  Results are cached in 'fixed' for the regular node. */
+static BtorAckFixedBits *
+get_fixed_bits (Btor *btor, BtorIntHashTable *fixed, BtorNode *exp)
+{
+  uint32_t i, bw;
+  BtorMemMgr *mm;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorHashTableData *d;
+  BtorAckFixedBits *fb, *fb0, *fb1;
+  BtorBitVector *v0, *v1;
+
+  mm = btor->mm;
+  BTOR_INIT_STACK (mm, visit);
+  BTOR_PUSH_STACK (visit, btor_node_real_addr (exp));
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_TOP_STACK (visit);
+    d   = btor_hashint_map_get (fixed, cur->id);
+
+    if (d && d->as_ptr)
+    {
+      (void) BTOR_POP_STACK (visit);
+      continue;
+    }
+
+    if (!d && btor_node_is_bv_concat (cur))
+    {
+      btor_hashint_map_add (fixed, cur->id);
+      for (i = 0; i < cur->arity; i++)
+        BTOR_PUSH_STACK (visit, btor_node_real_addr (cur->e[i]));
+      continue;
+    }
+
+    (void) BTOR_POP_STACK (visit);
+    bw = btor_node_bv_get_width (btor, cur);
+    BTOR_NEW (mm, fb);
+    if (btor_node_is_bv_const (cur))
+    {
+      fb->mask  = btor_bv_ones (mm, bw);
+      fb->value = btor_bv_copy (mm, btor_node_bv_const_get_bits (cur));
+    }
+    else if (btor_node_is_bv_concat (cur))
+    {
+      fb0       = get_cached_fixed_bits (fixed, cur->e[0]);
+      fb1       = get_cached_fixed_bits (fixed, cur->e[1]);
+      v0        = get_fixed_value (mm, fb0, btor_node_is_inverted (cur->e[0]));
+      v1        = get_fixed_value (mm, fb1, btor_node_is_inverted (cur->e[1]));
+      fb->mask  = btor_bv_concat (mm, fb0->mask, fb1->mask);
+      fb->value = btor_bv_concat (mm, v0, v1);
+      btor_bv_free (mm, v0);
+      btor_bv_free (mm, v1);
+    }
+    else
+    {
+      fb->mask  = btor_bv_new (mm, bw);
+      fb->value = btor_bv_new (mm, bw);
+    }
+    d = btor_hashint_map_get (fixed, cur->id);
+    if (!d) d = btor_hashint_map_add (fixed, cur->id);
+    d->as_ptr = fb;
+  }
+  BTOR_RELEASE_STACK (visit);
+
+  return get_cached_fixed_bits (fixed, exp);
+}
+
+static void
+delete_fixed_bits (Btor *btor, BtorIntHashTable *fixed)
+{
+  uint32_t i;
+  BtorAckFixedBits *fb;
+
+  for (i = 0; i < fixed->size; i++)
+  {
+    fb = fixed->data[i].as_ptr;
+    if (!fb) continue;
+    btor_bv_free (btor->mm, fb->mask);
+    btor_bv_free (btor->mm, fb->value);
+    BTOR_DELETE (btor->mm, fb);
+  }
+  btor_hashint_map_delete (fixed);
+}
+
+/* Partition 'applies' into buckets w.r.t. the values of the argument bits
+ * that are fixed in all applications with fixed argument bits.  Arguments
+ * of applications in different buckets are known to be distinct, hence
+ * only applications within the same bucket are constrained.  Applications
+ * that do not fix all of these bits are not constrained eagerly, their
+ * consistency is checked lazily by the function solver. */
+static uint32_t
+add_ackermann_constraints_buckets (Btor *btor,
+                                   BtorNodePtrStack *applies,
+                                   BtorIntHashTable *fixed)
+{
+  uint32_t i, k, nargs, res = 0;
+  bool residual;
+  BtorMemMgr *mm;
+  BtorNode *app, *arg;
+  BtorArgsIterator ait;
+  BtorAckFixedBits *fb;
+  BtorBitVector **dmask, *tmp;
+  BtorBitVectorTuple *key;
+  BtorPtrHashTable *buckets;
+  BtorPtrHashBucket *b;
+  BtorPtrHashTableIterator it;
+  BtorNodePtrStack *bucket;
+
+  mm    = btor->mm;
+  app   = BTOR_PEEK_STACK (*applies, 0);
+  nargs = btor_node_args_get_arity (btor, app->e[1]);
+  BTOR_CNEWN (mm, dmask, nargs);
+
+  /* collect bits that are fixed in all arguments with fixed bits */
+  for (i = 0; i < BTOR_COUNT_STACK (*applies); i++)
+  {
+    app = BTOR_PEEK_STACK (*applies, i);
+    btor_iter_args_init (&ait, app->e[1]);
+    for (k = 0; btor_iter_args_has_next (&ait); k++)
+    {
+      fb = get_fixed_bits (btor, fixed, btor_iter_args_next (&ait));
+      if (btor_bv_is_zero (fb->mask)) continue;
+      if (!dmask[k])
+        dmask[k] = btor_bv_copy (mm, fb->mask);
+      else
+      {
+        tmp      = dmask[k];
+        dmask[k] = btor_bv_and (mm, tmp, fb->mask);
+        btor_bv_free (mm, tmp);
+      }
+    }
+  }
+
+  buckets = btor_hashptr_table_new (mm,
+                                    (BtorHashPtr) btor_bv_hash_tuple,
+                                    (BtorCmpPtr) btor_bv_compare_tuple);
+  for (i = 0; i < BTOR_COUNT_STACK (*applies); i++)
+  {
+    app = BTOR_PEEK_STACK (*applies, i);
+
+    residual = false;
+    btor_iter_args_init (&ait, app->e[1]);
+    for (k = 0; !residual && btor_iter_args_has_next (&ait); k++)
+    {
+      fb = get_fixed_bits (btor, fixed, btor_iter_args_next (&ait));
+      if (!dmask[k]) continue;
+      tmp      = btor_bv_and (mm, fb->mask, dmask[k]);
+      residual = btor_bv_compare (tmp, dmask[k]) != 0;
+      btor_bv_free (mm, tmp);
+    }
+    if (residual) continue;
+
+    key = btor_bv_new_tuple (mm, nargs);
+    btor_iter_args_init (&ait, app->e[1]);
+    for (k = 0; btor_iter_args_has_next (&ait); k++)
+    {
+      arg = btor_iter_args_next (&ait);
+      if (!dmask[k])
+      {
+        key->bv[k] = btor_bv_new (mm, btor_node_bv_get_width (btor, arg));
+        continue;
+      }
+      fb         = get_fixed_bits (btor, fixed, arg);
+      tmp        = get_fixed_value (mm, fb, btor_node_is_inverted (arg));
+      key->bv[k] = btor_bv_and (mm, tmp, dmask[k]);
+      btor_bv_free (mm, tmp);
+    }
+
+    b = btor_hashptr_table_get (buckets, key);
+    if (b)
+    {
+      btor_bv_free_tuple (mm, key);
+      bucket = b->data.as_ptr;
+    }
+    else
+    {
+      BTOR_NEW (mm, bucket);
+      BTOR_INIT_STACK (mm, *bucket);
+      btor_hashptr_table_add (buckets, key)->data.as_ptr = bucket;
+    }
+    BTOR_PUSH_STACK (*bucket, app);
+  }
+
+  btor_iter_hashptr_init (&it, buckets);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    bucket = it.bucket->data.as_ptr;
+    key    = btor_iter_hashptr_next (&it);
+    res += add_ackermann_constraints_all (btor, bucket);
+    BTOR_RELEASE_STACK (*bucket);
+    BTOR_DELETE (mm, bucket);
+    btor_bv_free_tuple (mm, key);
+  }
+  btor_hashptr_table_delete (buckets);
+
+  for (k = 0; k < nargs; k++)
+    if (dmask[k]) btor_bv_free (mm, dmask[k]);
+  BTOR_DELETEN (mm, dmask, nargs);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
 void
 btor_add_ackermann_constraints (Btor *btor)
 {
   assert (btor);
 
-  uint32_t i, j, num_constraints = 0;
+  uint32_t i, n, num_constraints = 0;
+  uint64_t num_skipped = 0;
   double start, delta;
-  BtorNode *uf, *app_i, *app_j, *p, *c, *imp, *a_i, *a_j, *eq, *tmp;
+  BtorNode *uf, *app;
   BtorNode *cur;
-  BtorArgsIterator ait_i, ait_j;
   BtorNodeIterator nit;
   BtorPtrHashTableIterator it;
   BtorNodePtrStack applies, visit;
-  BtorIntHashTable *cache;
+  BtorIntHashTable *cache, *fixed;
   BtorMemMgr *mm;
 
   start = btor_util_time_stamp ();
   mm    = btor->mm;
   cache = btor_hashint_table_new (mm);
+  fixed = btor_hashint_map_new (mm);
   BTOR_INIT_STACK (mm, visit);
 
   btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
@@ -61,57 +356,34 @@ btor_add_ackermann_constraints (Btor *btor)
     btor_iter_apply_parent_init (&nit, uf);
     while (btor_iter_apply_parent_has_next (&nit))
     {
-      app_i = btor_iter_apply_parent_next (&nit);
-      if (app_i->parameterized) continue;
-      if (!btor_hashint_table_contains (cache, app_i->id)) continue;
-      BTOR_PUSH_STACK (applies, app_i);
+      app = btor_iter_apply_parent_next (&nit);
+      if (app->parameterized) continue;
+      if (!btor_hashint_table_contains (cache, app->id)) continue;
+      BTOR_PUSH_STACK (applies, app);
     }
 
-    for (i = 0; i < BTOR_COUNT_STACK (applies); i++)
+    n = BTOR_COUNT_STACK (applies);
+    if (n > 1)
     {
-      app_i = BTOR_PEEK_STACK (applies, i);
-      for (j = i + 1; j < BTOR_COUNT_STACK (applies); j++)
-      {
-        app_j = BTOR_PEEK_STACK (applies, j);
-        p     = 0;
-        assert (btor_node_get_sort_id (app_i->e[1])
-                == btor_node_get_sort_id (app_j->e[1]));
-        btor_iter_args_init (&ait_i, app_i->e[1]);
-        btor_iter_args_init (&ait_j, app_j->e[1]);
-        while (btor_iter_args_has_next (&ait_i))
-        {
-          a_i = btor_iter_args_next (&ait_i);
-          a_j = btor_iter_args_next (&ait_j);
-          eq  = btor_exp_eq (btor, a_i, a_j);
-
-          if (!p)
-            p = eq;
-          else
-          {
-            tmp = p;
-            p   = btor_exp_bv_and (btor, tmp, eq);
-            btor_node_release (btor, tmp);
-            btor_node_release (btor, eq);
-          }
-        }
-        c   = btor_exp_eq (btor, app_i, app_j);
-        imp = btor_exp_implies (btor, p, c);
-        btor->stats.ackermann_constraints++;
-        num_constraints++;
-        btor_assert_exp (btor, imp);
-        btor_node_release (btor, p);
-        btor_node_release (btor, c);
-        btor_node_release (btor, imp);
-      }
+      if (btor_opt_get (btor, BTOR_OPT_ACKERMANN_BUCKETS))
+        i = add_ackermann_constraints_buckets (btor, &applies, fixed);
+      else
+        i = add_ackermann_constraints_all (btor, &applies);
+      num_constraints += i;
+      num_skipped += (uint64_t) n * (n - 1) / 2 - i;
     }
     BTOR_RELEASE_STACK (applies);
   }
+  delete_fixed_bits (btor, fixed);
   btor_hashint_table_delete (cache);
+  btor->stats.ackermann_skipped += num_skipped;
   delta = btor_util_time_stamp () - start;
   BTOR_MSG (btor->msg,
             1,
-            "added %d ackermann constraints in %.3f seconds",
+            "added %d ackermann constraints (%llu pairs skipped) in %.3f "
+            "seconds",
             num_constraints,
+            (unsigned long long) num_skipped,
             delta);
   btor->time.ack += delta;
 }
@@ -0,0 +1,286 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btorbwreduce.h"
+
+#include "btorclone.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btormodel.h"
+#include "btorslvfun.h"
+#include "utils/btorhashint.h"
+#include "utils/btornodemap.h"
+#include "utils/btorutil.h"
+
+/*------------------------------------------------------------------------*/
+
+struct BtorBwReduceVar
+{
+  BtorNode *var;        /* variable of the original instance */
+  BtorNode *clone;      /* variable of the reduced instance */
+  uint32_t width;       /* restricted width, full width if not restricted */
+  BtorNode *assumption; /* restriction of 'clone' in the current round */
+};
+
+typedef struct BtorBwReduceVar BtorBwReduceVar;
+
+BTOR_DECLARE_STACK (BtorBwReduceVar, BtorBwReduceVar);
+
+/*------------------------------------------------------------------------*/
+
+static bool
+applies (Btor *btor)
+{
+  assert (btor->slv);
+
+  if (!btor_opt_get (btor, BTOR_OPT_BW_REDUCE)) return false;
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL)) return false;
+  if (btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS)) return false;
+  if (btor->slv->kind != BTOR_FUN_SOLVER_KIND) return false;
+  if (BTOR_FUN_SOLVER (btor)->lod_limit != -1
+      || BTOR_FUN_SOLVER (btor)->sat_limit != -1)
+    return false;
+  if (btor->ufs->count || btor->feqs->count || btor->quantifiers->count)
+    return false;
+  if (btor->assumptions->count) return false;
+  return true;
+}
+
+/* Collect the constraints and the variables in their cones that are wider
+ * than 'width'.  Returns false if there are no such variables. */
+static bool
+collect_vars (Btor *btor,
+              uint32_t width,
+              BtorNodePtrStack *roots,
+              BtorBwReduceVarStack *vars)
+{
+  uint32_t i;
+  bool res = true;
+  BtorNode *cur, *root;
+  BtorNodePtrStack visit;
+  BtorIntHashTable *mark;
+  BtorPtrHashTableIterator it;
+  BtorBwReduceVar v;
+
+  mark = btor_hashint_table_new (btor->mm);
+  BTOR_INIT_STACK (btor->mm, visit);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    root = btor_iter_hashptr_next (&it);
+    cur  = btor_node_real_addr (root);
+    /* the reduced instance is rebuilt from scratch, which does not work for
+     * lambdas that survived beta reduction */
+    if (cur->lambda_below || cur->apply_below)
+    {
+      res = false;
+      goto DONE;
+    }
+    BTOR_PUSH_STACK (*roots, root);
+    BTOR_PUSH_STACK (visit, cur);
+  }
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    btor_hashint_table_add (mark, cur->id);
+
+    if (btor_node_is_bv_var (cur)
+        && btor_node_bv_get_width (btor, cur) > width)
+    {
+      BTOR_CLR (&v);
+      v.var   = cur;
+      v.width = width;
+      BTOR_PUSH_STACK (*vars, v);
+    }
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  res = !BTOR_EMPTY_STACK (*vars);
+DONE:
+  BTOR_RELEASE_STACK (visit);
+  btor_hashint_table_delete (mark);
+  return res;
+}
+
+/* Check the model in 'btor->bv_model' against the original constraints. */
+static bool
+check_model (Btor *btor, BtorNodePtrStack *roots)
+{
+  uint32_t i;
+  bool res = true;
+  BtorBitVector *bv;
+
+  for (i = 0; res && i < BTOR_COUNT_STACK (*roots); i++)
+  {
+    bv  = btor_eval_exp (btor, BTOR_PEEK_STACK (*roots, i));
+    res = btor_bv_is_true (bv);
+    btor_bv_free (btor->mm, bv);
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+terminate_bw_reduce (void *state)
+{
+  return btor_terminate ((Btor *) state);
+}
+
+/* Restrict all variables with a reduced width to the sign extension of
+ * their least significant bits. */
+static uint32_t
+assume_restrictions (Btor *sub, BtorBwReduceVarStack *vars)
+{
+  uint32_t i, width, res = 0;
+  BtorNode *lsbs, *ext;
+  BtorBwReduceVar *v;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*vars); i++)
+  {
+    v     = vars->start + i;
+    width = btor_node_bv_get_width (sub, v->clone);
+    if (v->width == width) continue;
+    lsbs          = btor_exp_bv_slice (sub, v->clone, v->width - 1, 0);
+    ext           = btor_exp_bv_sext (sub, lsbs, width - v->width);
+    v->assumption = btor_exp_eq (sub, v->clone, ext);
+    btor_assume_exp (sub, v->assumption);
+    btor_node_release (sub, ext);
+    btor_node_release (sub, lsbs);
+    res++;
+  }
+  return res;
+}
+
+/* Widen all variables whose restriction is in the unsat core.  Returns the
+ * number of widened variables. */
+static uint32_t
+widen_failed (Btor *sub, BtorBwReduceVarStack *vars, bool unsat)
+{
+  uint32_t i, width, res = 0;
+  BtorBwReduceVar *v;
+
+  for (i = 0; i < BTOR_COUNT_STACK (*vars); i++)
+  {
+    v = vars->start + i;
+    if (!v->assumption) continue;
+    if (unsat && btor_failed_exp (sub, v->assumption))
+    {
+      width    = btor_node_bv_get_width (sub, v->clone);
+      v->width = BTOR_MIN_UTIL (2 * v->width, width);
+      res++;
+    }
+    btor_node_release (sub, v->assumption);
+    v->assumption = 0;
+  }
+  return res;
+}
+
+bool
+btor_bw_reduce_sat (Btor *btor, BtorSolverResult *result)
+{
+  assert (btor);
+  assert (result);
+
+  uint32_t i, num_restricted, num_widened, rounds;
+  double start;
+  bool reduced;
+  BtorSolverResult res;
+  Btor *sub;
+  BtorNode *root, *clone, *var;
+  BtorNodeMap *map;
+  BtorNodeMapIterator it;
+  BtorNodePtrStack roots;
+  BtorBwReduceVarStack vars;
+  BtorBwReduceVar *v;
+
+  if (!applies (btor)) return false;
+
+  start = btor_util_time_stamp ();
+
+  BTOR_INIT_STACK (btor->mm, roots);
+  BTOR_INIT_STACK (btor->mm, vars);
+  reduced = collect_vars (
+      btor, btor_opt_get (btor, BTOR_OPT_BW_REDUCE), &roots, &vars);
+  if (reduced)
+  {
+    sub = btor_new ();
+    btor_opt_delete_opts (sub);
+    btor_opt_clone_opts (btor, sub);
+    btor_opt_set (sub, BTOR_OPT_BW_REDUCE, 0);
+    btor_opt_set (sub, BTOR_OPT_DECOMPOSE, 0);
+    btor_opt_set (sub, BTOR_OPT_MODEL_GEN, 1);
+    btor_opt_set (sub, BTOR_OPT_INCREMENTAL, 1);
+    btor_set_msg_prefix (sub, "bwreduce");
+    btor_set_term (sub, terminate_bw_reduce, btor);
+
+    map = btor_nodemap_new (btor);
+    for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+    {
+      root  = BTOR_PEEK_STACK (roots, i);
+      clone = btor_clone_recursively_rebuild_exp (
+          btor, sub, root, map, btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL));
+      btor_assert_exp (sub, clone);
+      btor_node_release (sub, clone);
+    }
+    for (i = 0; i < BTOR_COUNT_STACK (vars); i++)
+    {
+      v        = vars.start + i;
+      v->clone = btor_nodemap_mapped (map, v->var);
+      assert (v->clone);
+    }
+
+    rounds = 0;
+    do
+    {
+      rounds++;
+      num_restricted = assume_restrictions (sub, &vars);
+      BTOR_MSG (btor->msg,
+                1,
+                "bit-width reduction round %u with %u restricted variables",
+                rounds,
+                num_restricted);
+      res         = btor_check_sat (sub, -1, -1);
+      num_widened = widen_failed (sub, &vars, res == BTOR_RESULT_UNSAT);
+    } while (res == BTOR_RESULT_UNSAT && num_widened > 0);
+    btor->stats.bw_reduce_rounds += rounds;
+
+    if (res == BTOR_RESULT_SAT)
+    {
+      btor_model_init_bv (btor, &btor->bv_model);
+      btor_iter_nodemap_init (&it, map);
+      while (btor_iter_nodemap_has_next (&it))
+      {
+        clone = it.it.bucket->data.as_ptr;
+        var   = btor_iter_nodemap_next (&it);
+        if (!btor_node_is_bv_var (var)) continue;
+        btor_model_add_to_bv (
+            btor, btor->bv_model, var, btor_model_get_bv (sub, clone));
+      }
+      /* every model of the restricted formula is a model of the original
+       * one, if the check still fails the formula is solved as a whole */
+      if (!check_model (btor, &roots))
+      {
+        BTOR_MSG (btor->msg, 1, "bit-width reduction model check failed");
+        btor_model_delete_bv (btor, &btor->bv_model);
+        reduced = false;
+      }
+    }
+    if (reduced) *result = res;
+
+    btor_nodemap_delete (map);
+    btor_delete (sub);
+  }
+
+  BTOR_RELEASE_STACK (vars);
+  BTOR_RELEASE_STACK (roots);
+
+  btor->time.bw_reduce += btor_util_time_stamp () - start;
+  return reduced;
+}
@@ -0,0 +1,21 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORBWREDUCE_H_INCLUDED
+#define BTORBWREDUCE_H_INCLUDED
+
+#include <stdbool.h>
+#include "btortypes.h"
+
+/* Solve the current constraints with all variables restricted to sign
+ * extended values of a smaller width, and widen restricted variables that
+ * occur in the unsat core until the result is conclusive.  Returns false if
+ * the formula is not eligible, in which case 'result' is not touched.  On
+ * SAT, the variable assignments are stored in 'btor->bv_model' and checked
+ * against the original constraints. */
+bool btor_bw_reduce_sat (Btor *btor, BtorSolverResult *result);
+
+#endif
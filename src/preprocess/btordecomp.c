@@ -0,0 +1,390 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "preprocess/btordecomp.h"
+
+#include "btorclone.h"
+#include "btorcore.h"
+#include "btorexp.h"
+#include "btormodel.h"
+#include "btorslvfun.h"
+#include "utils/btorhashint.h"
+#include "utils/btornodemap.h"
+#include "utils/btorunionfind.h"
+#include "utils/btorutil.h"
+
+#ifdef BTOR_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+/*------------------------------------------------------------------------*/
+
+struct BtorDecompComp
+{
+  BtorNodePtrStack roots; /* constraints of this component */
+  BtorSolverResult result;
+};
+
+typedef struct BtorDecompComp BtorDecompComp;
+
+BTOR_DECLARE_STACK (BtorDecompCompPtr, BtorDecompComp *);
+
+struct BtorDecomp
+{
+  Btor *btor;
+  BtorDecompCompPtrStack comps;
+  uint32_t next; /* index of next unsolved component */
+  bool done;     /* one of the components is unsat */
+  bool model;    /* merge models of sub-problems */
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_t mutex;
+#endif
+};
+
+typedef struct BtorDecomp BtorDecomp;
+
+/*------------------------------------------------------------------------*/
+
+/* The sub-instances are independent of each other, but building and tearing
+ * them down touches nodes and memory of the main instance. */
+
+static void
+lock (BtorDecomp *decomp)
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_lock (&decomp->mutex);
+#else
+  (void) decomp;
+#endif
+}
+
+static void
+unlock (BtorDecomp *decomp)
+{
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_unlock (&decomp->mutex);
+#else
+  (void) decomp;
+#endif
+}
+
+/*------------------------------------------------------------------------*/
+
+static bool
+applies (Btor *btor)
+{
+  assert (btor->slv);
+
+  if (!btor_opt_get (btor, BTOR_OPT_DECOMPOSE)) return false;
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL)) return false;
+  if (btor_opt_get (btor, BTOR_OPT_PRINT_DIMACS)) return false;
+  if (btor->slv->kind != BTOR_FUN_SOLVER_KIND) return false;
+  if (BTOR_FUN_SOLVER (btor)->lod_limit != -1
+      || BTOR_FUN_SOLVER (btor)->sat_limit != -1)
+    return false;
+  if (btor->ufs->count || btor->feqs->count || btor->quantifiers->count)
+    return false;
+  if (btor->assumptions->count) return false;
+  return true;
+}
+
+static bool
+need_model (Btor *btor)
+{
+  if (btor_opt_get (btor, BTOR_OPT_MODEL_GEN)) return true;
+#ifndef NDEBUG
+  /* btor_check_model generates a model even if model generation is off */
+  if (btor_opt_get (btor, BTOR_OPT_CHK_MODEL)) return true;
+#endif
+  return false;
+}
+
+/* Partition the constraints into sets that do not share any non-constant
+ * node.  Returns false if there are less than two such sets. */
+static bool
+compute_components (BtorDecomp *decomp)
+{
+  uint32_t i;
+  bool res = true;
+  Btor *btor;
+  BtorMemMgr *mm;
+  BtorNode *cur, *root, *e, *repr;
+  BtorNodePtrStack roots, visit;
+  BtorUnionFind *ufind;
+  BtorIntHashTable *mark, *repr2comp;
+  BtorHashTableData *d;
+  BtorPtrHashTableIterator it;
+  BtorDecompComp *comp;
+
+  btor = decomp->btor;
+  mm   = btor->mm;
+
+  ufind     = btor_ufind_new (mm);
+  mark      = btor_hashint_table_new (mm);
+  repr2comp = btor_hashint_map_new (mm);
+  BTOR_INIT_STACK (mm, roots);
+  BTOR_INIT_STACK (mm, visit);
+
+  btor_iter_hashptr_init (&it, btor->unsynthesized_constraints);
+  btor_iter_hashptr_queue (&it, btor->synthesized_constraints);
+  while (btor_iter_hashptr_has_next (&it))
+  {
+    root = btor_iter_hashptr_next (&it);
+    cur  = btor_node_real_addr (root);
+    /* sub-problems are rebuilt from scratch, which does not work for
+     * lambdas that survived beta reduction */
+    if (cur->lambda_below || cur->apply_below)
+    {
+      res = false;
+      goto DONE;
+    }
+    BTOR_PUSH_STACK (roots, root);
+    btor_ufind_add (ufind, cur);
+    BTOR_PUSH_STACK (visit, cur);
+  }
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = BTOR_POP_STACK (visit);
+    assert (btor_node_is_regular (cur));
+
+    if (btor_hashint_table_contains (mark, cur->id)) continue;
+    btor_hashint_table_add (mark, cur->id);
+
+    for (i = 0; i < cur->arity; i++)
+    {
+      e = btor_node_real_addr (cur->e[i]);
+      /* constants do not connect constraints */
+      if (btor_node_is_bv_const (e)) continue;
+      btor_ufind_merge (ufind, cur, e);
+      BTOR_PUSH_STACK (visit, e);
+    }
+  }
+
+  for (i = 0; i < BTOR_COUNT_STACK (roots); i++)
+  {
+    root = BTOR_PEEK_STACK (roots, i);
+    repr = btor_ufind_get_repr (ufind, btor_node_real_addr (root));
+    d    = btor_hashint_map_get (repr2comp, repr->id);
+    if (d)
+      comp = d->as_ptr;
+    else
+    {
+      BTOR_CNEW (mm, comp);
+      BTOR_INIT_STACK (mm, comp->roots);
+      comp->result = BTOR_RESULT_UNKNOWN;
+      BTOR_PUSH_STACK (decomp->comps, comp);
+      btor_hashint_map_add (repr2comp, repr->id)->as_ptr = comp;
+    }
+    BTOR_PUSH_STACK (comp->roots, root);
+  }
+
+  res = BTOR_COUNT_STACK (decomp->comps) > 1;
+DONE:
+  BTOR_RELEASE_STACK (visit);
+  BTOR_RELEASE_STACK (roots);
+  btor_hashint_map_delete (repr2comp);
+  btor_hashint_table_delete (mark);
+  btor_ufind_delete (ufind);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static int32_t
+terminate_decomp (void *state)
+{
+  BtorDecomp *decomp = state;
+  return decomp->done || btor_terminate (decomp->btor);
+}
+
+static void
+solve_component (BtorDecomp *decomp, BtorDecompComp *comp)
+{
+  uint32_t i;
+  BtorSolverResult res;
+  Btor *btor, *sub;
+  BtorNode *root, *var, *clone;
+  BtorNodeMap *map;
+  BtorNodeMapIterator it;
+  const BtorBitVector *bv;
+
+  btor = decomp->btor;
+
+  lock (decomp);
+  sub = btor_new ();
+  btor_opt_delete_opts (sub);
+  btor_opt_clone_opts (btor, sub);
+  btor_opt_set (sub, BTOR_OPT_DECOMPOSE, 0);
+  if (decomp->model) btor_opt_set (sub, BTOR_OPT_MODEL_GEN, 1);
+  btor_set_msg_prefix (sub, "decomp");
+  btor_set_term (sub, terminate_decomp, decomp);
+
+  map = btor_nodemap_new (btor);
+  for (i = 0; i < BTOR_COUNT_STACK (comp->roots); i++)
+  {
+    root  = BTOR_PEEK_STACK (comp->roots, i);
+    clone = btor_clone_recursively_rebuild_exp (
+        btor, sub, root, map, btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL));
+    btor_assert_exp (sub, clone);
+    btor_node_release (sub, clone);
+  }
+  unlock (decomp);
+
+  res = btor_check_sat (sub, -1, -1);
+
+  lock (decomp);
+  comp->result = res;
+  if (res == BTOR_RESULT_UNSAT)
+  {
+    decomp->done = true;
+  }
+  else if (res == BTOR_RESULT_SAT && decomp->model)
+  {
+    btor_iter_nodemap_init (&it, map);
+    while (btor_iter_nodemap_has_next (&it))
+    {
+      clone = it.it.bucket->data.as_ptr;
+      var   = btor_iter_nodemap_next (&it);
+      if (!btor_node_is_bv_var (var)) continue;
+      bv = btor_model_get_bv (sub, clone);
+      btor_model_add_to_bv (btor, btor->bv_model, var, bv);
+    }
+  }
+  btor_nodemap_delete (map);
+  unlock (decomp);
+
+  btor_delete (sub);
+}
+
+static BtorDecompComp *
+next_component (BtorDecomp *decomp)
+{
+  BtorDecompComp *res = 0;
+
+  lock (decomp);
+  if (!decomp->done && decomp->next < BTOR_COUNT_STACK (decomp->comps))
+  {
+    res = BTOR_PEEK_STACK (decomp->comps, decomp->next);
+    decomp->next++;
+  }
+  unlock (decomp);
+  return res;
+}
+
+static void
+solve_components (BtorDecomp *decomp)
+{
+  BtorDecompComp *comp;
+
+  while ((comp = next_component (decomp))) solve_component (decomp, comp);
+}
+
+#ifdef BTOR_HAVE_PTHREADS
+static void *
+thread_work (void *state)
+{
+  solve_components (state);
+  return NULL;
+}
+
+static void
+run_parallel (BtorDecomp *decomp, uint32_t num_threads)
+{
+  assert (num_threads > 1);
+
+  uint32_t i;
+  pthread_t *threads;
+
+  BTOR_NEWN (decomp->btor->mm, threads, num_threads - 1);
+  for (i = 0; i < num_threads - 1; i++)
+    pthread_create (&threads[i], 0, thread_work, decomp);
+  /* the calling thread is a worker, too */
+  solve_components (decomp);
+  for (i = 0; i < num_threads - 1; i++) pthread_join (threads[i], 0);
+  BTOR_DELETEN (decomp->btor->mm, threads, num_threads - 1);
+}
+#endif
+
+/*------------------------------------------------------------------------*/
+
+bool
+btor_decompose_sat (Btor *btor, BtorSolverResult *result)
+{
+  assert (btor);
+  assert (result);
+
+  uint32_t i, num_comps, num_threads;
+  double start;
+  bool decomposed;
+  BtorSolverResult res;
+  BtorDecomp decomp;
+  BtorDecompComp *comp;
+
+  if (!applies (btor)) return false;
+
+  start = btor_util_time_stamp ();
+
+  BTOR_CLR (&decomp);
+  decomp.btor = btor;
+  BTOR_INIT_STACK (btor->mm, decomp.comps);
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_init (&decomp.mutex, 0);
+#endif
+
+  decomposed = compute_components (&decomp);
+  num_comps  = BTOR_COUNT_STACK (decomp.comps);
+  if (decomposed)
+  {
+    num_threads = btor_opt_get (btor, BTOR_OPT_DECOMPOSE);
+    if (num_threads > num_comps) num_threads = num_comps;
+    BTOR_MSG (btor->msg,
+              1,
+              "solving %u independent components with %u thread(s)",
+              num_comps,
+              num_threads);
+    btor->stats.decomp_components += num_comps;
+
+    decomp.model = need_model (btor);
+    if (decomp.model) btor_model_init_bv (btor, &btor->bv_model);
+
+#ifdef BTOR_HAVE_PTHREADS
+    if (num_threads > 1)
+      run_parallel (&decomp, num_threads);
+    else
+#endif
+      solve_components (&decomp);
+
+    res = BTOR_RESULT_SAT;
+    for (i = 0; i < num_comps; i++)
+    {
+      comp = BTOR_PEEK_STACK (decomp.comps, i);
+      if (comp->result == BTOR_RESULT_UNSAT)
+      {
+        res = BTOR_RESULT_UNSAT;
+        break;
+      }
+      if (comp->result == BTOR_RESULT_UNKNOWN) res = BTOR_RESULT_UNKNOWN;
+    }
+    if (res != BTOR_RESULT_SAT && btor->bv_model)
+      btor_model_delete_bv (btor, &btor->bv_model);
+    *result = res;
+  }
+
+  for (i = 0; i < num_comps; i++)
+  {
+    comp = BTOR_PEEK_STACK (decomp.comps, i);
+    BTOR_RELEASE_STACK (comp->roots);
+    BTOR_DELETE (btor->mm, comp);
+  }
+  BTOR_RELEASE_STACK (decomp.comps);
+#ifdef BTOR_HAVE_PTHREADS
+  pthread_mutex_destroy (&decomp.mutex);
+#endif
+
+  btor->time.decomp += btor_util_time_stamp () - start;
+  return decomposed;
+}
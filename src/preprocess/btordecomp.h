@@ -0,0 +1,20 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#ifndef BTORDECOMP_H_INCLUDED
+#define BTORDECOMP_H_INCLUDED
+
+#include <stdbool.h>
+#include "btortypes.h"
+
+/* Split the current constraints into independent sub-problems (constraints
+ * without common variables) and solve each of them in a separate instance.
+ * Returns false if the formula can not be decomposed, in which case 'result'
+ * is not touched and the formula has to be solved as a whole.  On SAT, the
+ * variable assignments of all components are merged into 'btor->bv_model'. */
+bool btor_decompose_sat (Btor *btor, BtorSolverResult *result);
+
+#endif
@@ -39,6 +39,54 @@ eliminate_update_nodes (Btor *btor)
   btor_delete_substitutions (btor);
 }
 
+/* Push applications into function conditionals, i.e., rewrite
+ * (c ? f : g)(a) to c ? f(a) : g(a), until no application on a function
+ * conditional is left.  Function conditionals below function equalities
+ * are not affected. */
+static void
+eliminate_fun_cond_applies (Btor *btor)
+{
+  uint32_t i, num_applies;
+  BtorNode *cur, *app, *then_app, *else_app, *subst;
+  BtorNodeIterator it;
+  BtorPtrHashTableIterator h_it;
+  BtorPtrHashTable *substs;
+
+  do
+  {
+    num_applies = 0;
+    substs      = btor_hashptr_table_new (btor->mm,
+                                     (BtorHashPtr) btor_node_hash_by_id,
+                                     (BtorCmpPtr) btor_node_compare_by_id);
+    for (i = 1; i < BTOR_COUNT_STACK (btor->nodes_id_table); i++)
+    {
+      cur = BTOR_PEEK_STACK (btor->nodes_id_table, i);
+      if (!cur || !btor_node_is_fun_cond (cur) || btor_node_is_simplified (cur))
+        continue;
+      btor_iter_apply_parent_init (&it, cur);
+      while (btor_iter_apply_parent_has_next (&it))
+      {
+        app = btor_iter_apply_parent_next (&it);
+        if (btor_node_is_simplified (app)
+            || btor_hashptr_table_get (substs, app))
+          continue;
+        then_app = btor_exp_apply (btor, cur->e[1], app->e[1]);
+        else_app = btor_exp_apply (btor, cur->e[2], app->e[1]);
+        subst    = btor_exp_cond (btor, cur->e[0], then_app, else_app);
+        btor_node_release (btor, then_app);
+        btor_node_release (btor, else_app);
+        btor_hashptr_table_add (substs, app)->data.as_ptr = subst;
+        num_applies++;
+      }
+    }
+    btor_substitute_and_rebuild (btor, substs);
+    btor_iter_hashptr_init (&h_it, substs);
+    while (btor_iter_hashptr_has_next (&h_it))
+      btor_node_release (btor, btor_iter_hashptr_next_data (&h_it)->as_ptr);
+    btor_hashptr_table_delete (substs);
+  } while (num_applies > 0);
+}
+
 void
 btor_eliminate_applies (Btor *btor)
 {
@@ -51,22 +99,19 @@ btor_eliminate_applies (Btor *btor)
   BtorNodeIterator it;
   BtorNodePtrStack lambdas;
   BtorPtrHashTableIterator h_it;
-  BtorPtrHashTable *cache;
   BtorPtrHashTable *substs;
   BtorIntHashTable *app_cache;
 
   if (btor_opt_get (btor, BTOR_OPT_BETA_REDUCE) == BTOR_BETA_REDUCE_ALL)
   {
     eliminate_update_nodes (btor);
+    eliminate_fun_cond_applies (btor);
   }
 
   if (btor->lambdas->count == 0) return;
 
   start     = btor_util_time_stamp ();
   round     = 1;
-  cache     = btor_hashptr_table_new (btor->mm,
-                                  (BtorHashPtr) btor_node_pair_hash,
-                                  (BtorCmpPtr) btor_node_pair_compare);
   app_cache = btor_hashint_table_new (btor->mm);
   BTOR_INIT_STACK (btor->mm, lambdas);
 
@@ -105,7 +150,7 @@ btor_eliminate_applies (Btor *btor)
         if (btor->quantifiers->count == 0 && app->parameterized) continue;
 
         num_applies++;
-        subst = btor_beta_reduce_full (btor, app, cache);
+        subst = btor_beta_reduce_full (btor, app);
         assert (!btor_hashptr_table_get (substs, app));
         btor_hashptr_table_add (substs, app)->data.as_ptr = subst;
         btor_hashint_table_add (app_cache, btor_node_get_id (app));
@@ -135,13 +180,9 @@ btor_eliminate_applies (Btor *btor)
 
   btor_hashint_table_delete (app_cache);
 
-  btor_iter_hashptr_init (&h_it, cache);
-  while (btor_iter_hashptr_has_next (&h_it))
-  {
-    btor_node_release (btor, h_it.bucket->data.as_ptr);
-    btor_node_pair_delete (btor, btor_iter_hashptr_next (&h_it));
-  }
-  btor_hashptr_table_delete (cache);
+  /* beta reduction results are kept for the next call unless disabled */
+  if (!btor_opt_get (btor, BTOR_OPT_BETA_REDUCE_CACHE))
+    btor_beta_cache_reset (btor);
 
 #ifndef NDEBUG
   BTOR_RESET_STACK (lambdas);
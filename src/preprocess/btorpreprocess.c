@@ -11,11 +11,13 @@
 
 #include "preprocess/btorpreprocess.h"
 
+#include "btoraigvec.h"
 #include "btorcore.h"
 #include "btordbg.h"
 #include "btorexp.h"
 #include "btorlog.h"
 #include "btorsubst.h"
+#include "preprocess/btorabsint.h"
 #include "preprocess/btorack.h"
 #include "preprocess/btorder.h"
 #include "preprocess/btorelimapplies.h"
@@ -33,20 +35,204 @@
 #include "utils/btornodeiter.h"
 #include "utils/btorutil.h"
 
+/*------------------------------------------------------------------------*/
+
+static const char *const g_btor_pp_pass2str[BTOR_PP_NUM_PASSES] = {
+    "slice elimination",
+    "skeleton preprocessing",
+    "unconstrained optimization",
+    "lambda extraction",
+    "lambda merging",
+    "abstract interpretation",
+    "adder normalization",
+};
+
+/* Scheduling state of the optional passes for one btor_simplify call. */
+struct BtorPPSchedule
+{
+  double deadline;                 /* 0 if no time budget */
+  double pass_budget;              /* 0 if no per pass budget */
+  double time[BTOR_PP_NUM_PASSES]; /* time per pass in this call */
+};
+typedef struct BtorPPSchedule BtorPPSchedule;
+
+static void
+init_schedule (Btor *btor, BtorPPSchedule *sched, double start)
+{
+  uint32_t budget;
+
+  BTOR_CLR (sched);
+  if ((budget = btor_opt_get (btor, BTOR_OPT_SIMP_TIME_BUDGET)))
+    sched->deadline = start + budget / 1000.0;
+  if ((budget = btor_opt_get (btor, BTOR_OPT_SIMP_PASS_BUDGET)))
+    sched->pass_budget = budget / 1000.0;
+}
+
+static bool
+skip_pass (Btor *btor, BtorPPSchedule *sched, BtorPPPass pass)
+{
+  uint32_t limit;
+  BtorPPPassStats *stats;
+
+  stats = &btor->stats.pp_passes[pass];
+
+  if (sched->deadline > 0 && btor_util_time_stamp () >= sched->deadline)
+  {
+    BTOR_MSG (btor->msg,
+              2,
+              "skipping %s, time budget exhausted",
+              g_btor_pp_pass2str[pass]);
+    return true;
+  }
+
+  if (sched->pass_budget > 0 && sched->time[pass] >= sched->pass_budget)
+  {
+    BTOR_MSG (btor->msg,
+              2,
+              "skipping %s, pass budget exhausted",
+              g_btor_pp_pass2str[pass]);
+    return true;
+  }
+
+  /* Skip passes that did not pay off in the last 'limit' runs.  After being
+   * skipped 'limit' times, a pass is retried once. */
+  limit = btor_opt_get (btor, BTOR_OPT_SIMP_SKIP_UNPRODUCTIVE);
+  if (limit && stats->unproductive >= limit)
+  {
+    if (stats->unproductive - limit < limit)
+    {
+      stats->unproductive += 1;
+      BTOR_MSG (btor->msg,
+                2,
+                "skipping %s, no reduction in the last %u runs",
+                g_btor_pp_pass2str[pass],
+                limit);
+      return true;
+    }
+    stats->unproductive = limit - 1;
+  }
+  return false;
+}
+
+static uint_least64_t
+num_aigs (Btor *btor)
+{
+  return btor_aigvec_get_aig_mgr (btor->avmgr)->cur_num_aigs;
+}
+
+/* Run optional preprocessing pass 'pass' unless it is skipped, and record
+ * how much it reduced the formula.  A pass is considered productive if it
+ * reduced the number of nodes or AIGs, or if it produced new variable
+ * substitutions or embedded constraints (which are processed in the next
+ * round).  Returns true if the pass was run. */
+static bool
+run_pass (Btor *btor,
+          BtorPPSchedule *sched,
+          BtorPPPass pass,
+          void (*fun) (Btor *))
+{
+  double start, delta;
+  uint32_t nodes, varsubst, embedded;
+  uint_least64_t aigs;
+  int64_t dnodes, daigs;
+  BtorPPPassStats *stats;
+
+  stats = &btor->stats.pp_passes[pass];
+
+  if (skip_pass (btor, sched, pass))
+  {
+    stats->skipped += 1;
+    return false;
+  }
+
+  start    = btor_util_time_stamp ();
+  nodes    = btor->nodes_unique_table.num_elements;
+  aigs     = num_aigs (btor);
+  varsubst = btor->varsubst_constraints->count;
+  embedded = btor->embedded_constraints->count;
+
+  fun (btor);
+
+  delta  = btor_util_time_stamp () - start;
+  dnodes = (int64_t) nodes - (int64_t) btor->nodes_unique_table.num_elements;
+  daigs  = (int64_t) aigs - (int64_t) num_aigs (btor);
+
+  stats->runs += 1;
+  stats->time += delta;
+  stats->nodes += dnodes;
+  stats->aigs += daigs;
+  sched->time[pass] += delta;
+
+  if (dnodes > 0 || daigs > 0 || btor->inconsistent
+      || btor->varsubst_constraints->count > varsubst
+      || btor->embedded_constraints->count > embedded)
+    stats->unproductive = 0;
+  else
+    stats->unproductive += 1;
+  return true;
+}
+
+void
+btor_print_pp_pass_stats (Btor *btor)
+{
+  assert (btor);
+
+  uint32_t i;
+  BtorPPPassStats *stats;
+
+  for (i = 0; i < BTOR_PP_NUM_PASSES; i++)
+    if (btor->stats.pp_passes[i].runs || btor->stats.pp_passes[i].skipped)
+      break;
+  if (i == BTOR_PP_NUM_PASSES) return;
+
+  BTOR_MSG (btor->msg, 1, "");
+  BTOR_MSG (btor->msg, 1, "simplification passes:");
+  BTOR_MSG (btor->msg,
+            1,
+            "  %8s %8s %10s %10s %10s %s",
+            "runs",
+            "skipped",
+            "nodes",
+            "aigs",
+            "seconds",
+            "pass");
+  for (i = 0; i < BTOR_PP_NUM_PASSES; i++)
+  {
+    stats = &btor->stats.pp_passes[i];
+    if (!stats->runs && !stats->skipped) continue;
+    BTOR_MSG (btor->msg,
+              1,
+              "  %8u %8u %10lld %10lld %10.2f %s",
+              stats->runs,
+              stats->skipped,
+              (long long) stats->nodes,
+              (long long) stats->aigs,
+              stats->time,
+              g_btor_pp_pass2str[i]);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
 int32_t
 btor_simplify (Btor *btor)
 {
   assert (btor);
 
   BtorSolverResult result;
-  uint32_t rounds;
+  BtorPPSchedule sched;
+  uint32_t rounds, beta_reduce;
+  bool incremental_simp;
   double start, delta;
 #ifndef BTOR_DO_NOT_PROCESS_SKELETON
   uint32_t skelrounds = 0;
 #endif
 
-  rounds = 0;
-  start  = btor_util_time_stamp ();
+  rounds           = 0;
+  start            = btor_util_time_stamp ();
+  incremental_simp = !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+                     || btor_opt_get (btor, BTOR_OPT_INCREMENTAL_SIMP);
+  init_schedule (btor, &sched, start);
 
   if (btor->valid_assignments) btor_reset_incremental_usage (btor);
 
@@ -105,11 +291,16 @@ btor_simplify (Btor *btor)
       if (btor->varsubst_constraints->count) continue;
     }
 
+    /* slice elimination only introduces definitions for the eliminated
+     * variables and is therefore also safe in incremental mode */
     if (btor_opt_get (btor, BTOR_OPT_ELIMINATE_SLICES)
         && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+        && incremental_simp)
     {
-      btor_eliminate_slices_on_bv_vars (btor);
+      run_pass (btor,
+                &sched,
+                BTOR_PP_PASS_ELIM_SLICES,
+                btor_eliminate_slices_on_bv_vars);
       if (btor->inconsistent)
       {
         BTORLOG (1, "formula inconsistent after slice elimination");
@@ -125,10 +316,11 @@ btor_simplify (Btor *btor)
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_SKELETON_PREPROC))
     {
-      skelrounds++;
-      if (skelrounds <= 1)  // TODO only one?
+      if (skelrounds < 1  // TODO only one?
+          && run_pass (
+              btor, &sched, BTOR_PP_PASS_SKELETON, btor_process_skeleton))
       {
-        btor_process_skeleton (btor);
+        skelrounds++;
         if (btor->inconsistent)
         {
           BTORLOG (1, "formula inconsistent after skeleton preprocessing");
@@ -147,10 +339,10 @@ btor_simplify (Btor *btor)
 
     if (btor_opt_get (btor, BTOR_OPT_UCOPT)
         && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
-        && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+        && incremental_simp
         && !btor_opt_get (btor, BTOR_OPT_MODEL_GEN))
     {
-      btor_optimize_unconstrained (btor);
+      run_pass (btor, &sched, BTOR_PP_PASS_UCOPT, btor_optimize_unconstrained);
       if (btor->inconsistent)
       {
         BTORLOG (1, "formula inconsistent after skeleton preprocessing");
@@ -163,11 +355,24 @@ btor_simplify (Btor *btor)
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_EXTRACT_LAMBDAS))
-      btor_extract_lambdas (btor);
+      run_pass (
+          btor, &sched, BTOR_PP_PASS_EXTRACT_LAMBDAS, btor_extract_lambdas);
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_MERGE_LAMBDAS))
-      btor_merge_lambdas (btor);
+      run_pass (btor, &sched, BTOR_PP_PASS_MERGE_LAMBDAS, btor_merge_lambdas);
+
+    if (btor_opt_get (btor, BTOR_OPT_ABSINT)
+        && btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
+        && incremental_simp)
+    {
+      run_pass (btor, &sched, BTOR_PP_PASS_ABSINT, btor_absint_simplify);
+      if (btor->inconsistent)
+      {
+        BTORLOG (1, "formula inconsistent after abstract interpretation");
+        break;
+      }
+    }
 
     if (btor->varsubst_constraints->count || btor->embedded_constraints->count)
       continue;
@@ -176,9 +381,12 @@ btor_simplify (Btor *btor)
     if (btor_opt_get (btor, BTOR_OPT_BETA_REDUCE))
     {
       /* If no UFs or function equalities are present, we eagerly eliminate all
-       * remaining lambdas. */
-      if (btor->ufs->count == 0 && btor->feqs->count == 0
-          && !btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+       * remaining lambdas.  In incremental mode, UFs or function equalities
+       * may still be added later, hence we only do this for the current
+       * call. */
+      beta_reduce = btor_opt_get (btor, BTOR_OPT_BETA_REDUCE);
+      if (btor->ufs->count == 0 && btor->feqs->count == 0 && incremental_simp
+          && beta_reduce != BTOR_BETA_REDUCE_ALL)
       {
         BTOR_MSG (btor->msg,
                   1,
@@ -186,6 +394,8 @@ btor_simplify (Btor *btor)
         btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, BTOR_BETA_REDUCE_ALL);
       }
       btor_eliminate_applies (btor);
+      if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL))
+        btor_opt_set (btor, BTOR_OPT_BETA_REDUCE, beta_reduce);
     }
 
     /* add ackermann constraints for all uninterpreted functions */
@@ -194,7 +404,7 @@ btor_simplify (Btor *btor)
 
     if (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2
         && btor_opt_get (btor, BTOR_OPT_SIMP_NORMAMLIZE_ADDERS))
-      btor_normalize_adds (btor);
+      run_pass (btor, &sched, BTOR_PP_PASS_NORMALIZE_ADDS, btor_normalize_adds);
 
   } while (btor->varsubst_constraints->count
            || btor->embedded_constraints->count);
@@ -13,6 +13,35 @@
 
 #include "btortypes.h"
 
+/* Optional preprocessing passes, scheduled by btor_simplify. */
+enum BtorPPPass
+{
+  BTOR_PP_PASS_ELIM_SLICES,
+  BTOR_PP_PASS_SKELETON,
+  BTOR_PP_PASS_UCOPT,
+  BTOR_PP_PASS_EXTRACT_LAMBDAS,
+  BTOR_PP_PASS_MERGE_LAMBDAS,
+  BTOR_PP_PASS_ABSINT,
+  BTOR_PP_PASS_NORMALIZE_ADDS,
+  BTOR_PP_NUM_PASSES
+};
+typedef enum BtorPPPass BtorPPPass;
+
+/* Per pass statistics, used to decide whether a pass is worth running. */
+struct BtorPPPassStats
+{
+  uint32_t runs;         /* number of runs */
+  uint32_t skipped;      /* number of skipped runs */
+  uint32_t unproductive; /* number of consecutive runs without reduction */
+  int64_t nodes;         /* reduction of the number of nodes */
+  int64_t aigs;          /* reduction of the number of AIGs */
+  double time;           /* time spent */
+};
+typedef struct BtorPPPassStats BtorPPPassStats;
+
 int32_t btor_simplify (Btor* btor);
 
+/* Print preprocessing pass statistics. */
+void btor_print_pp_pass_stats (Btor* btor);
+
 #endif
@@ -80,12 +80,58 @@ mark_uc (Btor *btor, BtorIntHashTable *uc, BtorNode *exp)
   btor_node_release (btor, subst);
 }
 
+/* In incremental mode, terms that can still be referenced by future
+ * assertions or assumptions are not unconstrained, even if they currently
+ * occur only once.  Collect the cones of all expressions held by the user,
+ * symbols, assumptions and context levels.  Note that terms that may only be
+ * retrieved via boolector_match_node_by_id are not considered. */
+static void
+collect_open (Btor *btor, BtorIntHashTable *open)
+{
+  uint32_t i;
+  BtorNode *cur;
+  BtorNodePtrStack visit;
+  BtorPtrHashTableIterator it;
+
+  BTOR_INIT_STACK (btor->mm, visit);
+  for (i = 1; i < BTOR_COUNT_STACK (btor->nodes_id_table); i++)
+  {
+    cur = BTOR_PEEK_STACK (btor->nodes_id_table, i);
+    if (cur && cur->ext_refs) BTOR_PUSH_STACK (visit, cur);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions); i++)
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (btor->assertions, i));
+  for (i = 0; i < BTOR_COUNT_STACK (btor->assertions_actlits); i++)
+  {
+    cur = BTOR_PEEK_STACK (btor->assertions_actlits, i);
+    if (cur) BTOR_PUSH_STACK (visit, cur);
+  }
+  for (i = 0; i < BTOR_COUNT_STACK (btor->retired_actlits); i++)
+    BTOR_PUSH_STACK (visit, BTOR_PEEK_STACK (btor->retired_actlits, i));
+  btor_iter_hashptr_init (&it, btor->node2symbol);
+  btor_iter_hashptr_queue (&it, btor->assumptions);
+  btor_iter_hashptr_queue (&it, btor->orig_assumptions);
+  while (btor_iter_hashptr_has_next (&it))
+    BTOR_PUSH_STACK (visit, btor_iter_hashptr_next (&it));
+
+  while (!BTOR_EMPTY_STACK (visit))
+  {
+    cur = btor_node_real_addr (BTOR_POP_STACK (visit));
+    if (btor_hashint_table_contains (open, cur->id)) continue;
+    btor_hashint_table_add (open, cur->id);
+    if (cur->simplified) BTOR_PUSH_STACK (visit, cur->simplified);
+    for (i = 0; i < cur->arity; i++) BTOR_PUSH_STACK (visit, cur->e[i]);
+  }
+  BTOR_RELEASE_STACK (visit);
+}
+
 void
 btor_optimize_unconstrained (Btor *btor)
 {
   assert (btor);
   assert (btor_opt_get (btor, BTOR_OPT_REWRITE_LEVEL) > 2);
-  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL));
+  assert (!btor_opt_get (btor, BTOR_OPT_INCREMENTAL)
+          || btor_opt_get (btor, BTOR_OPT_INCREMENTAL_SIMP));
   assert (!btor_opt_get (btor, BTOR_OPT_MODEL_GEN));
 
   double start, delta;
@@ -99,6 +145,7 @@ btor_optimize_unconstrained (Btor *btor)
   BtorIntHashTable *ucs;  /* unconstrained candidate nodes */
   BtorIntHashTable *ucsp; /* parameterized unconstrained candidate nodes */
   BtorIntHashTable *mark;
+  BtorIntHashTable *open; /* nodes that may be referenced in the future */
   BtorHashTableData *d;
 
   if (btor->bv_vars->count == 0 && btor->ufs->count == 0) return;
@@ -114,6 +161,8 @@ btor_optimize_unconstrained (Btor *btor)
   mark = btor_hashint_map_new (mm);
   ucs  = btor_hashint_table_new (mm);
   ucsp = btor_hashint_table_new (mm);
+  open = btor_hashint_table_new (mm);
+  if (btor_opt_get (btor, BTOR_OPT_INCREMENTAL)) collect_open (btor, open);
   btor_init_substitutions (btor);
 
   /* collect nodes that might contribute to a unconstrained candidate
@@ -127,7 +176,7 @@ btor_optimize_unconstrained (Btor *btor)
 
     if (btor_node_is_simplified (cur)) continue;
 
-    if (cur->parents == 1)
+    if (cur->parents == 1 && !btor_hashint_table_contains (open, cur->id))
     {
       cur_parent = btor_node_real_addr (cur->first_parent);
       btor_hashint_table_add (ucs, cur->id);
@@ -191,7 +240,8 @@ btor_optimize_unconstrained (Btor *btor)
       btor_hashint_map_remove (mark, cur->id, 0);
 
       /* propagate unconstrained candidates */
-      if (cur->parents == 0 || (cur->parents == 1 && !cur->constraint))
+      if ((cur->parents == 0 || (cur->parents == 1 && !cur->constraint))
+          && !btor_hashint_table_contains (open, cur->id))
       {
         for (i = 0; i < cur->arity; i++)
         {
@@ -272,6 +322,7 @@ btor_optimize_unconstrained (Btor *btor)
   btor_delete_substitutions (btor);
   btor_hashint_table_delete (ucs);
   btor_hashint_table_delete (ucsp);
+  btor_hashint_table_delete (open);
   BTOR_RELEASE_STACK (stack);
   BTOR_RELEASE_STACK (roots);
 
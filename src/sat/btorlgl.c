@@ -249,6 +249,13 @@ melt (BtorSATMgr *smgr, int32_t lit)
   if (smgr->inc_required) lglmelt (blgl->lgl, lit);
 }
 
+static void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  BtorLGL *blgl = smgr->solver;
+  lglsetphase (blgl->lgl, lit);
+}
+
 static int32_t
 failed (BtorSATMgr *smgr, int32_t lit)
 {
@@ -321,6 +328,7 @@ btor_sat_enable_lingeling (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = inc_max_var;
   smgr->api.init             = init;
   smgr->api.melt             = melt;
+  smgr->api.phase            = phase;
   smgr->api.repr             = repr;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
@@ -97,6 +97,12 @@ fixed (BtorSATMgr *smgr, int32_t lit)
   return picosat_deref_toplevel (smgr->solver, lit);
 }
 
+static void
+phase (BtorSATMgr *smgr, int32_t lit)
+{
+  picosat_set_default_phase_lit (smgr->solver, lit, 1);
+}
+
 /*------------------------------------------------------------------------*/
 
 static void
@@ -133,6 +139,7 @@ btor_sat_enable_picosat (BtorSATMgr *smgr)
   smgr->api.inc_max_var      = inc_max_var;
   smgr->api.init             = init;
   smgr->api.melt             = 0;
+  smgr->api.phase            = phase;
   smgr->api.repr             = 0;
   smgr->api.reset            = reset;
   smgr->api.sat              = sat;
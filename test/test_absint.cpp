@@ -0,0 +1,127 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestAbsInt : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_ABSINT, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    d_s8 = boolector_bitvec_sort (d_btor, 8);
+  }
+
+  void TearDown () override
+  {
+    boolector_release_sort (d_btor, d_s8);
+    TestBoolector::TearDown ();
+  }
+
+  void assert_binary (BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      BoolectorNode *b)
+  {
+    BoolectorNode *n = fun (d_btor, a, b);
+    boolector_assert (d_btor, n);
+    boolector_release (d_btor, n);
+  }
+
+  void assert_binary (BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      uint32_t b)
+  {
+    BoolectorNode *c;
+    c = boolector_unsigned_int (d_btor, b, boolector_get_sort (d_btor, a));
+    assert_binary (fun, a, c);
+    boolector_release (d_btor, c);
+  }
+
+  uint64_t get_value (BoolectorNode *n)
+  {
+    const char *bits = boolector_bv_assignment (d_btor, n);
+    uint64_t res     = strtoull (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  BoolectorSort d_s8;
+};
+
+/* the sum of two zero extended bytes fits into 9 bits */
+TEST_F (TestAbsInt, narrow_add)
+{
+  BoolectorNode *x, *y, *ex, *ey, *sum;
+
+  x   = boolector_var (d_btor, d_s8, "x");
+  y   = boolector_var (d_btor, d_s8, "y");
+  ex  = boolector_uext (d_btor, x, 24);
+  ey  = boolector_uext (d_btor, y, 24);
+  sum = boolector_add (d_btor, ex, ey);
+  assert_binary (boolector_eq, sum, 300);
+  assert_binary (boolector_ugt, x, 200);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.absint_substitutions, 0u);
+  ASSERT_GT (get_value (x), 200u);
+  ASSERT_EQ (get_value (x) + get_value (y), 300u);
+
+  boolector_release (d_btor, sum);
+  boolector_release (d_btor, ex);
+  boolector_release (d_btor, ey);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+}
+
+/* x < 16 fixes the upper nibble of x */
+TEST_F (TestAbsInt, seed_unsat)
+{
+  BoolectorNode *x, *msbs;
+
+  x    = boolector_var (d_btor, d_s8, "x");
+  msbs = boolector_slice (d_btor, x, 7, 4);
+  assert_binary (boolector_ult, x, 16);
+  assert_binary (boolector_eq, msbs, 1);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_GT (d_btor->stats.absint_substitutions, 0u);
+
+  boolector_release (d_btor, msbs);
+  boolector_release (d_btor, x);
+}
+
+/* the constraints the bounds are derived from must be kept */
+TEST_F (TestAbsInt, seed_sat)
+{
+  BoolectorNode *x, *y, *ex, *prod;
+
+  x    = boolector_var (d_btor, d_s8, "x");
+  y    = boolector_var (d_btor, d_s8, "y");
+  ex   = boolector_uext (d_btor, x, 24);
+  prod = boolector_mul (d_btor, ex, ex);
+  assert_binary (boolector_ugt, x, 9);
+  assert_binary (boolector_ult, x, 13);
+  assert_binary (boolector_ugte, prod, 144);
+  assert_binary (boolector_ult, y, x);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.absint_substitutions, 0u);
+  ASSERT_EQ (get_value (x), 12u);
+  ASSERT_LT (get_value (y), 12u);
+
+  boolector_release (d_btor, prod);
+  boolector_release (d_btor, ex);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, x);
+}
@@ -0,0 +1,142 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestAck : public TestBoolector
+{
+ protected:
+  static constexpr uint32_t s_num_apps = 20;
+
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_ACKERMANN, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_ACKERMANN_BUCKETS, 1);
+    d_s8  = boolector_bitvec_sort (d_btor, 8);
+    d_s4  = boolector_bitvec_sort (d_btor, 4);
+    d_s12 = boolector_bitvec_sort (d_btor, 12);
+    d_fs  = boolector_fun_sort (d_btor, &d_s12, 1, d_s8);
+    d_f   = boolector_uf (d_btor, d_fs, "f");
+  }
+
+  void TearDown () override
+  {
+    boolector_release (d_btor, d_f);
+    boolector_release_sort (d_btor, d_fs);
+    boolector_release_sort (d_btor, d_s12);
+    boolector_release_sort (d_btor, d_s4);
+    boolector_release_sort (d_btor, d_s8);
+    TestBoolector::TearDown ();
+  }
+
+  /* f (c :: x) with constant prefix 'c' */
+  BoolectorNode *apply_prefixed (uint32_t c, BoolectorNode *x)
+  {
+    BoolectorNode *prefix, *arg, *res;
+    prefix = boolector_unsigned_int (d_btor, c, d_s4);
+    arg    = boolector_concat (d_btor, prefix, x);
+    res    = boolector_apply (d_btor, &arg, 1, d_f);
+    boolector_release (d_btor, prefix);
+    boolector_release (d_btor, arg);
+    return res;
+  }
+
+  void assert_binary (BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      BoolectorNode *b)
+  {
+    BoolectorNode *n = fun (d_btor, a, b);
+    boolector_assert (d_btor, n);
+    boolector_release (d_btor, n);
+  }
+
+  /* assert x = y without enabling variable substitution */
+  void assert_equal (BoolectorNode *x, BoolectorNode *y)
+  {
+    assert_binary (boolector_ulte, x, y);
+    assert_binary (boolector_ugte, x, y);
+  }
+
+  BoolectorSort d_s4, d_s8, d_s12, d_fs;
+  BoolectorNode *d_f;
+};
+
+TEST_F (TestAck, buckets_distinct)
+{
+  uint32_t i;
+  BoolectorNode *x, *apps[s_num_apps];
+
+  x = boolector_var (d_btor, d_s8, "x");
+  for (i = 0; i < s_num_apps; i++)
+  {
+    apps[i] = apply_prefixed (i % 16, x);
+    if (i > 0) assert_binary (boolector_ne, apps[i - 1], apps[i]);
+  }
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  /* only applications with the same prefix are constrained */
+  ASSERT_LT (d_btor->stats.ackermann_constraints,
+             s_num_apps * (s_num_apps - 1) / 2);
+  ASSERT_GT (d_btor->stats.ackermann_skipped, 0u);
+
+  for (i = 0; i < s_num_apps; i++) boolector_release (d_btor, apps[i]);
+  boolector_release (d_btor, x);
+}
+
+TEST_F (TestAck, buckets_unsat)
+{
+  BoolectorNode *x, *y, *z, *fx, *fy, *fz;
+
+  x  = boolector_var (d_btor, d_s8, "x");
+  y  = boolector_var (d_btor, d_s8, "y");
+  z  = boolector_var (d_btor, d_s8, "z");
+  fx = apply_prefixed (3, x);
+  fy = apply_prefixed (3, y);
+  fz = apply_prefixed (5, z);
+  assert_equal (x, y);
+  assert_equal (y, z);
+  assert_binary (boolector_ne, fx, fy);
+  assert_binary (boolector_ne, fx, fz);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, fx);
+  boolector_release (d_btor, fy);
+  boolector_release (d_btor, fz);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, z);
+}
+
+/* applications without fixed argument bits are checked lazily */
+TEST_F (TestAck, buckets_residual)
+{
+  BoolectorNode *x, *w, *c, *arg, *fx, *fw;
+
+  x   = boolector_var (d_btor, d_s8, "x");
+  w   = boolector_var (d_btor, d_s12, "w");
+  c   = boolector_unsigned_int (d_btor, 7, d_s4);
+  arg = boolector_concat (d_btor, c, x);
+  fx  = apply_prefixed (7, x);
+  fw  = boolector_apply (d_btor, &w, 1, d_f);
+  assert_equal (w, arg);
+  assert_binary (boolector_ne, fx, fw);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_GT (d_btor->stats.ackermann_skipped, 0u);
+
+  boolector_release (d_btor, fx);
+  boolector_release (d_btor, fw);
+  boolector_release (d_btor, arg);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, w);
+  boolector_release (d_btor, x);
+}
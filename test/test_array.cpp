@@ -0,0 +1,114 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+#include "btorslvfun.h"
+}
+
+class TestArray : public TestBoolector
+{
+ protected:
+  static constexpr uint32_t s_num_writes = 64;
+
+  /* Build a chain of writes to symbolic indices on top of 'd_base' and
+   * return the read of the top of the chain at 'd_idx'. */
+  BoolectorNode *mk_write_chain ()
+  {
+    uint32_t i;
+    BoolectorNode *arr, *tmp;
+
+    d_sort  = boolector_bitvec_sort (d_btor, 16);
+    d_asort = boolector_array_sort (d_btor, d_sort, d_sort);
+    d_base  = boolector_array (d_btor, d_asort, 0);
+    d_idx   = boolector_var (d_btor, d_sort, 0);
+
+    arr = boolector_copy (d_btor, d_base);
+    for (i = 0; i < s_num_writes; i++)
+    {
+      d_indices[i] = boolector_var (d_btor, d_sort, 0);
+      d_values[i]  = boolector_var (d_btor, d_sort, 0);
+      tmp          = boolector_write (d_btor, arr, d_indices[i], d_values[i]);
+      boolector_release (d_btor, arr);
+      arr = tmp;
+    }
+    tmp = boolector_read (d_btor, arr, d_idx);
+    boolector_release (d_btor, arr);
+    return tmp;
+  }
+
+  void release_write_chain ()
+  {
+    for (uint32_t i = 0; i < s_num_writes; i++)
+    {
+      boolector_release (d_btor, d_indices[i]);
+      boolector_release (d_btor, d_values[i]);
+    }
+    boolector_release (d_btor, d_base);
+    boolector_release (d_btor, d_idx);
+    boolector_release_sort (d_btor, d_asort);
+    boolector_release_sort (d_btor, d_sort);
+  }
+
+  BoolectorSort d_sort, d_asort;
+  BoolectorNode *d_base, *d_idx;
+  BoolectorNode *d_indices[s_num_writes];
+  BoolectorNode *d_values[s_num_writes];
+};
+
+TEST_F (TestArray, update_chain_unsat)
+{
+  uint32_t i;
+  BoolectorNode *rd, *brd, *ne;
+
+  rd = mk_write_chain ();
+  for (i = 0; i < s_num_writes; i++)
+  {
+    ne = boolector_ne (d_btor, d_idx, d_indices[i]);
+    boolector_assert (d_btor, ne);
+    boolector_release (d_btor, ne);
+  }
+  /* no write matches, hence the value is read from the base array */
+  brd = boolector_read (d_btor, d_base, d_idx);
+  ne  = boolector_ne (d_btor, rd, brd);
+  boolector_assert (d_btor, ne);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_GT (BTOR_FUN_SOLVER (d_btor)->stats.propagations_skipped, 0u);
+
+  boolector_release (d_btor, rd);
+  boolector_release (d_btor, brd);
+  boolector_release (d_btor, ne);
+  release_write_chain ();
+}
+
+TEST_F (TestArray, update_chain_sat)
+{
+  BoolectorNode *rd, *eq, *c;
+  const char *bits;
+
+  boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  rd = mk_write_chain ();
+  /* the read has to skip the writes above the 10th write */
+  eq = boolector_eq (d_btor, d_idx, d_indices[10]);
+  boolector_assert (d_btor, eq);
+  boolector_release (d_btor, eq);
+  c  = boolector_int (d_btor, 4711, d_sort);
+  eq = boolector_eq (d_btor, rd, c);
+  boolector_assert (d_btor, eq);
+  boolector_release (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  bits = boolector_bv_assignment (d_btor, rd);
+  ASSERT_EQ (strtoull (bits, 0, 2), 4711u);
+  boolector_free_bv_assignment (d_btor, bits);
+
+  boolector_release (d_btor, rd);
+  boolector_release (d_btor, c);
+  release_write_chain ();
+}
@@ -0,0 +1,126 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestBwReduce : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_BW_REDUCE, 8);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  }
+
+  void assert_binary (BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      BoolectorNode *b)
+  {
+    BoolectorNode *n = fun (d_btor, a, b);
+    boolector_assert (d_btor, n);
+    boolector_release (d_btor, n);
+  }
+
+  void assert_binary (BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      uint32_t b)
+  {
+    BoolectorNode *c;
+    c = boolector_unsigned_int (d_btor, b, boolector_get_sort (d_btor, a));
+    assert_binary (fun, a, c);
+    boolector_release (d_btor, c);
+  }
+
+  uint64_t get_value (BoolectorNode *n)
+  {
+    const char *bits = boolector_bv_assignment (d_btor, n);
+    uint64_t res     = strtoull (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+};
+
+/* a witness that fits into the initial width */
+TEST_F (TestBwReduce, sat_small)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *prod;
+
+  s    = boolector_bitvec_sort (d_btor, 64);
+  x    = boolector_var (d_btor, s, "x");
+  y    = boolector_var (d_btor, s, "y");
+  prod = boolector_mul (d_btor, x, y);
+  assert_binary (boolector_eq, prod, 143);
+  assert_binary (boolector_ugt, x, 1);
+  assert_binary (boolector_ugt, y, 1);
+  assert_binary (boolector_ult, x, y);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.bw_reduce_rounds, 1u);
+  ASSERT_EQ (get_value (x), 11u);
+  ASSERT_EQ (get_value (y), 13u);
+
+  boolector_release (d_btor, prod);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release_sort (d_btor, s);
+}
+
+/* the witness needs more than 16 bits */
+TEST_F (TestBwReduce, sat_widen)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *sum;
+
+  s   = boolector_bitvec_sort (d_btor, 32);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  sum = boolector_add (d_btor, x, y);
+  assert_binary (boolector_ugt, x, 70000);
+  assert_binary (boolector_ult, x, 70010);
+  assert_binary (boolector_eq, sum, 70020);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.bw_reduce_rounds, 3u);
+  ASSERT_GT (get_value (x), 70000u);
+  ASSERT_LT (get_value (x), 70010u);
+  ASSERT_EQ (get_value (x) + get_value (y), 70020u);
+
+  boolector_release (d_btor, sum);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release_sort (d_btor, s);
+}
+
+/* unsat at every width, the restrictions are relaxed up to the full width */
+TEST_F (TestBwReduce, unsat)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *sum;
+
+  s   = boolector_bitvec_sort (d_btor, 16);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  sum = boolector_add (d_btor, x, y);
+  assert_binary (boolector_eq, sum, 1000);
+  assert_binary (boolector_ult, x, 5);
+  assert_binary (boolector_ult, y, 900);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.bw_reduce_rounds, 2u);
+
+  boolector_release (d_btor, sum);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release_sort (d_btor, s);
+}
@@ -0,0 +1,142 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestDecomp : public TestBoolector
+{
+ protected:
+  static constexpr uint32_t s_num_comps = 4;
+
+  /* Assert 'x_i * y_i = c_i' with x_i, y_i > 1 for independent x_i, y_i.
+   * If 'unsat' is true, c_1 is prime and the multiplication must not
+   * overflow. */
+  void mk_factor_components (uint32_t num_threads, bool unsat)
+  {
+    uint32_t i;
+    BoolectorSort s;
+    BoolectorNode *one, *prod, *eq, *c, *ovf;
+
+    boolector_set_opt (d_btor, BTOR_OPT_DECOMPOSE, num_threads);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+
+    s   = boolector_bitvec_sort (d_btor, 16);
+    one = boolector_one (d_btor, s);
+    for (i = 0; i < s_num_comps; i++)
+    {
+      d_x[i] = boolector_var (d_btor, s, 0);
+      d_y[i] = boolector_var (d_btor, s, 0);
+      assert_ugt (d_x[i], one);
+      assert_ugt (d_y[i], one);
+      prod = boolector_mul (d_btor, d_x[i], d_y[i]);
+      /* 7919 is prime */
+      c  = boolector_int (d_btor, unsat && i == 1 ? 7919 : 143 + i * 1000, s);
+      eq = boolector_eq (d_btor, prod, c);
+      boolector_assert (d_btor, eq);
+      boolector_release (d_btor, c);
+      boolector_release (d_btor, eq);
+      boolector_release (d_btor, prod);
+      if (unsat && i == 1)
+      {
+        ovf = boolector_umulo (d_btor, d_x[i], d_y[i]);
+        eq  = boolector_not (d_btor, ovf);
+        boolector_assert (d_btor, eq);
+        boolector_release (d_btor, eq);
+        boolector_release (d_btor, ovf);
+      }
+    }
+    boolector_release (d_btor, one);
+    boolector_release_sort (d_btor, s);
+  }
+
+  void assert_ugt (BoolectorNode *a, BoolectorNode *b)
+  {
+    BoolectorNode *gt = boolector_ugt (d_btor, a, b);
+    boolector_assert (d_btor, gt);
+    boolector_release (d_btor, gt);
+  }
+
+  void release_vars ()
+  {
+    for (uint32_t i = 0; i < s_num_comps; i++)
+    {
+      boolector_release (d_btor, d_x[i]);
+      boolector_release (d_btor, d_y[i]);
+    }
+  }
+
+  void test_decomp_sat (uint32_t num_threads)
+  {
+    uint32_t i;
+    uint64_t x, y;
+    const char *bits;
+
+    mk_factor_components (num_threads, false);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    ASSERT_EQ (d_btor->stats.decomp_components, s_num_comps);
+    for (i = 0; i < s_num_comps; i++)
+    {
+      bits = boolector_bv_assignment (d_btor, d_x[i]);
+      x    = strtoull (bits, 0, 2);
+      boolector_free_bv_assignment (d_btor, bits);
+      bits = boolector_bv_assignment (d_btor, d_y[i]);
+      y    = strtoull (bits, 0, 2);
+      boolector_free_bv_assignment (d_btor, bits);
+      ASSERT_GT (x, 1u);
+      ASSERT_GT (y, 1u);
+      ASSERT_EQ ((x * y) & 0xffff, 143u + i * 1000);
+    }
+    release_vars ();
+  }
+
+  BoolectorNode *d_x[s_num_comps];
+  BoolectorNode *d_y[s_num_comps];
+};
+
+TEST_F (TestDecomp, sat)
+{
+  test_decomp_sat (1);
+}
+
+TEST_F (TestDecomp, sat_threads)
+{
+  test_decomp_sat (3);
+}
+
+TEST_F (TestDecomp, unsat)
+{
+  mk_factor_components (2, true);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.decomp_components, s_num_comps);
+  release_vars ();
+}
+
+TEST_F (TestDecomp, single_component)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *gt, *lt;
+
+  boolector_set_opt (d_btor, BTOR_OPT_DECOMPOSE, 2);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  x  = boolector_var (d_btor, s, 0);
+  y  = boolector_var (d_btor, s, 0);
+  gt = boolector_ugt (d_btor, x, y);
+  lt = boolector_ult (d_btor, x, y);
+  boolector_assert (d_btor, gt);
+  boolector_assert (d_btor, lt);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.decomp_components, 0u);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, gt);
+  boolector_release (d_btor, lt);
+  boolector_release_sort (d_btor, s);
+}
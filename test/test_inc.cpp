@@ -12,7 +12,9 @@
 #include "test.h"
 
 extern "C" {
+#include "btorcore.h"
 #include "btoropt.h"
+#include "btorslvfun.h"
 }
 
 class TestInc : public TestBoolector
@@ -258,3 +260,293 @@ TEST_F (TestInc, lemmas_on_demand1)
   boolector_release_sort (d_btor, s);
   boolector_release_sort (d_btor, as);
 }
+
+TEST_F (TestInc, skip_unproductive_passes)
+{
+  uint32_t i;
+  int32_t res;
+  BoolectorNode *x, *y, *ult;
+  BoolectorSort s;
+  BtorPPPassStats *stats;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_SIMP_SKIP_UNPRODUCTIVE, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  ult = boolector_ult (d_btor, x, y);
+
+  /* no arrays, lambda extraction never reduces the formula */
+  for (i = 0; i < 4; i++)
+  {
+    boolector_assume (d_btor, ult);
+    res = boolector_sat (d_btor);
+    ASSERT_EQ (res, BOOLECTOR_SAT);
+  }
+  stats = &d_btor->stats.pp_passes[BTOR_PP_PASS_EXTRACT_LAMBDAS];
+  ASSERT_EQ (stats->runs, 2u);
+  ASSERT_EQ (stats->skipped, 2u);
+  ASSERT_EQ (stats->nodes, 0);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, ult);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, actlit_scopes)
+{
+  BoolectorNode *x, *y, *ult, *ugt, *eq;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  ult = boolector_ult (d_btor, x, y);
+  ugt = boolector_ugt (d_btor, x, y);
+  eq  = boolector_eq (d_btor, x, y);
+
+  boolector_push (d_btor, 1);
+  boolector_assert (d_btor, ult);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_push (d_btor, 2);
+  boolector_assert (d_btor, ugt);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  /* scoped assertions are guarded constraints, not assumptions */
+  ASSERT_EQ (BTOR_COUNT_STACK (d_btor->assertions), 0u);
+  ASSERT_EQ (BTOR_COUNT_STACK (d_btor->assertions_actlits), 3u);
+  ASSERT_EQ (d_btor->assumptions->count, 2u);
+  boolector_pop (d_btor, 2);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  boolector_pop (d_btor, 1);
+  ASSERT_EQ (BTOR_COUNT_STACK (d_btor->assertions_actlits), 0u);
+  boolector_assert (d_btor, ugt);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, ult);
+  boolector_release (d_btor, ugt);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, incremental_ucopt)
+{
+  BoolectorNode *x, *y, *sl, *c, *eq, *zero;
+  BoolectorSort s, s4;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_UCOPT, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_ELIMINATE_SLICES, 0);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  s4 = boolector_bitvec_sort (d_btor, 4);
+  x  = boolector_var (d_btor, s, 0);
+  y  = boolector_var (d_btor, s, 0);
+  c  = boolector_int (d_btor, 15, s4);
+
+  /* 'y' is released and can not be constrained anymore */
+  sl = boolector_slice (d_btor, y, 3, 0);
+  eq = boolector_eq (d_btor, sl, c);
+  boolector_assert (d_btor, eq);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, sl);
+  boolector_release (d_btor, eq);
+
+  /* 'x' is still held and must not be treated as unconstrained */
+  sl = boolector_slice (d_btor, x, 3, 0);
+  eq = boolector_eq (d_btor, sl, c);
+  boolector_assert (d_btor, eq);
+  boolector_release (d_btor, sl);
+  boolector_release (d_btor, eq);
+
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_EQ (d_btor->stats.bv_uc_props, 2u);
+
+  zero = boolector_zero (d_btor, s);
+  eq   = boolector_eq (d_btor, x, zero);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, zero);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, s4);
+}
+
+TEST_F (TestInc, incremental_eliminate_slices)
+{
+  BoolectorNode *x, *sl, *c, *eq;
+  BoolectorSort s, s4;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_ELIMINATE_SLICES, 1);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  s4 = boolector_bitvec_sort (d_btor, 4);
+  x  = boolector_var (d_btor, s, "x");
+  sl = boolector_slice (d_btor, x, 3, 0);
+  c  = boolector_int (d_btor, 15, s4);
+  eq = boolector_ult (d_btor, sl, c);
+  boolector_assert (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+  ASSERT_GT (d_btor->stats.eliminated_slices, 0u);
+  boolector_release (d_btor, eq);
+
+  /* new constraints on 'x' are rewritten in terms of its slices */
+  eq = boolector_eq (d_btor, sl, c);
+  boolector_assume (d_btor, eq);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, sl);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, eq);
+  boolector_release_sort (d_btor, s);
+  boolector_release_sort (d_btor, s4);
+}
+
+TEST_F (TestInc, sat_gc)
+{
+  uint32_t i;
+  BoolectorNode *x, *y, *z, *mul, *c, *eq, *gt;
+  BoolectorSort s;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_SAT_GC, 50);
+  s  = boolector_bitvec_sort (d_btor, 8);
+  x  = boolector_var (d_btor, s, 0);
+  c  = boolector_int (d_btor, 5, s);
+  gt = boolector_ugt (d_btor, x, c);
+  boolector_assert (d_btor, gt);
+  boolector_release (d_btor, gt);
+
+  for (i = 0; i < 4; i++)
+  {
+    /* the AIGs of 'mul' are deleted after each round */
+    y   = boolector_var (d_btor, s, 0);
+    z   = boolector_var (d_btor, s, 0);
+    mul = boolector_mul (d_btor, y, z);
+    eq  = boolector_eq (d_btor, mul, x);
+    boolector_assume (d_btor, eq);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    boolector_release (d_btor, y);
+    boolector_release (d_btor, z);
+    boolector_release (d_btor, mul);
+    boolector_release (d_btor, eq);
+
+    /* the constraint on 'x' survives rebuilding the SAT instance */
+    eq = boolector_ult (d_btor, x, c);
+    boolector_assume (d_btor, eq);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+    boolector_release (d_btor, eq);
+  }
+  ASSERT_GT (d_btor->stats.sat_rebuilds, 0u);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, c);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, keep_init_apps)
+{
+  uint32_t i;
+  BoolectorNode *a, *x, *idx, *rd, *eq, *c, *le;
+  BoolectorSort s, as;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  as  = boolector_array_sort (d_btor, s, s);
+  a   = boolector_array (d_btor, as, 0);
+  x   = boolector_var (d_btor, s, 0);
+  idx = boolector_var (d_btor, s, 0);
+  rd  = boolector_read (d_btor, a, idx);
+  eq  = boolector_ugt (d_btor, rd, x);
+  boolector_assert (d_btor, eq);
+  boolector_release (d_btor, eq);
+
+  for (i = 0; i < 3; i++)
+  {
+    c  = boolector_int (d_btor, i, s);
+    eq = boolector_eq (d_btor, idx, c);
+    boolector_assume (d_btor, eq);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    /* the apply of the constraint is collected once and kept */
+    if (i == 0)
+      ASSERT_EQ (BTOR_COUNT_STACK (BTOR_FUN_SOLVER (d_btor)->init_apps), 1u);
+    boolector_release (d_btor, rd);
+
+    rd = boolector_read (d_btor, a, c);
+    le = boolector_ulte (d_btor, rd, x);
+    boolector_assume (d_btor, eq);
+    boolector_assume (d_btor, le);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+    /* lemmas are added as constraints, at most one new apply per round */
+    ASSERT_LE (BTOR_COUNT_STACK (BTOR_FUN_SOLVER (d_btor)->init_apps), i + 2);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, le);
+  }
+
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, idx);
+  boolector_release (d_btor, rd);
+  boolector_release_sort (d_btor, as);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestInc, dual_prop_clone)
+{
+  uint32_t i;
+  Btor *clone;
+  BoolectorNode *a, *x, *idx, *rd, *gt, *c, *eq, *le;
+  BoolectorSort s, as;
+
+  boolector_set_opt (d_btor, BTOR_OPT_INCREMENTAL, 1);
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_DUAL_PROP, 1);
+  s   = boolector_bitvec_sort (d_btor, 8);
+  as  = boolector_array_sort (d_btor, s, s);
+  a   = boolector_array (d_btor, as, 0);
+  x   = boolector_var (d_btor, s, 0);
+  idx = boolector_var (d_btor, s, 0);
+  rd  = boolector_read (d_btor, a, idx);
+  gt  = boolector_ugt (d_btor, rd, x);
+  boolector_assert (d_btor, gt);
+  boolector_release (d_btor, gt);
+  boolector_release (d_btor, rd);
+
+  for (i = 0; i < 3; i++)
+  {
+    c  = boolector_int (d_btor, i, s);
+    eq = boolector_eq (d_btor, idx, c);
+    rd = boolector_read (d_btor, a, c);
+    le = boolector_ulte (d_btor, rd, x);
+    boolector_assume (d_btor, eq);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    boolector_assume (d_btor, eq);
+    boolector_assume (d_btor, le);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, eq);
+    boolector_release (d_btor, rd);
+    boolector_release (d_btor, le);
+  }
+  /* new assertions are added to the existing clone */
+  ASSERT_EQ (BTOR_FUN_SOLVER (d_btor)->stats.dp_clones, 1u);
+
+  clone = boolector_clone (d_btor);
+  ASSERT_EQ (boolector_sat (clone), BOOLECTOR_SAT);
+  boolector_delete (clone);
+
+  boolector_release (d_btor, a);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, idx);
+  boolector_release_sort (d_btor, as);
+  boolector_release_sort (d_btor, s);
+}
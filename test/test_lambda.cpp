@@ -107,7 +107,7 @@ class TestLambda : public TestBtor
       cur = btor_node_real_addr (cur->e[1]);
     }
 
-    result = btor_beta_reduce_full (btor, lambda, 0);
+    result = btor_beta_reduce_full (btor, lambda);
 
     while (!BTOR_EMPTY_STACK (unassign))
     {
@@ -1130,7 +1130,7 @@ TEST_F (TestLambda, reduce_nested_lambdas_add1)
   btor_node_release (d_btor, result);
 
   BtorNode *apply = btor_exp_apply_n (d_btor, fun, args, 2);
-  result          = btor_beta_reduce_full (d_btor, apply, 0);
+  result          = btor_beta_reduce_full (d_btor, apply);
   ASSERT_EQ (result, expected);
 
   btor_node_release (d_btor, apply);
@@ -1144,6 +1144,43 @@ TEST_F (TestLambda, reduce_nested_lambdas_add1)
   btor_node_release (d_btor, a);
 }
 
+/* results of full beta reduction are reused until they get released */
+TEST_F (TestLambda, reduce_full_cache)
+{
+  BtorNode *result;
+  BtorNode *a, *b, *x, *y, *add, *fun, *apply;
+
+  a                   = btor_exp_var (d_btor, d_elem_sort, "a");
+  b                   = btor_exp_var (d_btor, d_elem_sort, "b");
+  BtorNode *args[2]   = {a, b};
+  x                   = btor_exp_param (d_btor, d_elem_sort, "x");
+  y                   = btor_exp_param (d_btor, d_elem_sort, "y");
+  BtorNode *params[2] = {x, y};
+  add                 = btor_exp_bv_add (d_btor, x, y);
+  fun                 = btor_exp_fun (d_btor, params, 2, add);
+  apply               = btor_exp_apply_n (d_btor, fun, args, 2);
+
+  result = btor_beta_reduce_full (d_btor, apply);
+  ASSERT_EQ (d_btor->stats.beta_cache_hits, 0u);
+  btor_node_release (d_btor, btor_beta_reduce_full (d_btor, apply));
+  ASSERT_EQ (d_btor->stats.beta_cache_hits, 1u);
+
+  /* cached result does not exist anymore */
+  btor_node_release (d_btor, result);
+  result = btor_beta_reduce_full (d_btor, apply);
+  ASSERT_EQ (d_btor->stats.beta_cache_hits, 1u);
+  ASSERT_TRUE (btor_node_is_bv_add (result));
+
+  btor_node_release (d_btor, result);
+  btor_node_release (d_btor, apply);
+  btor_node_release (d_btor, fun);
+  btor_node_release (d_btor, add);
+  btor_node_release (d_btor, y);
+  btor_node_release (d_btor, x);
+  btor_node_release (d_btor, b);
+  btor_node_release (d_btor, a);
+}
+
 /* (lambda x . (x + read(lambda y . y, b))) (a) */
 TEST_F (TestLambda, reduce_nested_lambdas_add2)
 {
@@ -1241,7 +1278,7 @@ TEST_F (TestLambda, reduce_nested_lambdas_const_n1000)
   btor_node_release (d_btor, result);
 
   BtorNode *apply = btor_exp_apply_n (d_btor, fun, indices, nesting_lvl);
-  result          = btor_beta_reduce_full (d_btor, apply, 0);
+  result          = btor_beta_reduce_full (d_btor, apply);
   ASSERT_EQ (result, var);
 
   for (i = 0; i < nesting_lvl; i++)
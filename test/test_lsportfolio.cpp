@@ -0,0 +1,105 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestLsPortfolio : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+  }
+
+  void assert_binary (BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      uint32_t b)
+  {
+    BoolectorNode *c, *n;
+    c = boolector_unsigned_int (d_btor, b, boolector_get_sort (d_btor, a));
+    n = fun (d_btor, a, c);
+    boolector_assert (d_btor, n);
+    boolector_release (d_btor, n);
+    boolector_release (d_btor, c);
+  }
+
+  uint64_t get_value (BoolectorNode *n)
+  {
+    const char *bits = boolector_bv_assignment (d_btor, n);
+    uint64_t res     = strtoull (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  void test_factor (uint32_t engine, uint32_t num_workers)
+  {
+    BoolectorSort s;
+    BoolectorNode *x, *y, *prod;
+
+    boolector_set_opt (d_btor, BTOR_OPT_ENGINE, engine);
+    boolector_set_opt (d_btor, BTOR_OPT_LS_PORTFOLIO, num_workers);
+
+    s    = boolector_bitvec_sort (d_btor, 16);
+    x    = boolector_var (d_btor, s, "x");
+    y    = boolector_var (d_btor, s, "y");
+    prod = boolector_mul (d_btor, x, y);
+    assert_binary (boolector_eq, prod, 143);
+    assert_binary (boolector_ugt, x, 1);
+    assert_binary (boolector_ugt, y, 1);
+    assert_binary (boolector_ult, x, 20);
+    assert_binary (boolector_ult, y, 20);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    ASSERT_EQ (d_btor->stats.ls_portfolio_workers, num_workers);
+    ASSERT_EQ (get_value (x) * get_value (y), 143u);
+
+    boolector_release (d_btor, prod);
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, y);
+    boolector_release_sort (d_btor, s);
+  }
+};
+
+/* the portfolio is only applied if Boolector was built with pthreads */
+#ifdef BTOR_HAVE_PTHREADS
+TEST_F (TestLsPortfolio, sat_prop) { test_factor (BTOR_ENGINE_PROP, 4); }
+
+TEST_F (TestLsPortfolio, sat_sls) { test_factor (BTOR_ENGINE_SLS, 4); }
+
+TEST_F (TestLsPortfolio, sat_aigprop) { test_factor (BTOR_ENGINE_AIGPROP, 2); }
+
+/* local search can not show unsat, the fun engine worker has to */
+TEST_F (TestLsPortfolio, unsat_prop)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *sum;
+
+  boolector_set_opt (d_btor, BTOR_OPT_ENGINE, BTOR_ENGINE_PROP);
+  boolector_set_opt (d_btor, BTOR_OPT_LS_PORTFOLIO, 2);
+
+  s   = boolector_bitvec_sort (d_btor, 16);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  sum = boolector_add (d_btor, x, y);
+  assert_binary (boolector_eq, sum, 1000);
+  assert_binary (boolector_ult, x, 5);
+  assert_binary (boolector_ult, y, 900);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+  ASSERT_EQ (d_btor->stats.ls_portfolio_workers, 2u);
+
+  boolector_release (d_btor, sum);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release_sort (d_btor, s);
+}
+#endif
@@ -0,0 +1,101 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+}
+
+class TestPreseed : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_ENGINE, BTOR_ENGINE_FUN);
+    boolector_set_opt (d_btor, BTOR_OPT_FUN_PRESEED, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    /* give up local search early to get to the SAT solver */
+    boolector_set_opt (d_btor, BTOR_OPT_PROP_NPROPS, 1);
+    boolector_set_opt (d_btor, BTOR_OPT_SLS_NFLIPS, 1);
+  }
+
+  void assert_binary (BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      uint32_t b)
+  {
+    BoolectorNode *c, *n;
+    c = boolector_unsigned_int (d_btor, b, boolector_get_sort (d_btor, a));
+    n = fun (d_btor, a, c);
+    boolector_assert (d_btor, n);
+    boolector_release (d_btor, n);
+    boolector_release (d_btor, c);
+  }
+
+  uint64_t get_value (BoolectorNode *n)
+  {
+    const char *bits = boolector_bv_assignment (d_btor, n);
+    uint64_t res     = strtoull (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  void test_factor (BtorOption pre)
+  {
+    BoolectorSort s;
+    BoolectorNode *x, *y, *prod;
+
+    boolector_set_opt (d_btor, pre, 1);
+
+    s    = boolector_bitvec_sort (d_btor, 16);
+    x    = boolector_var (d_btor, s, "x");
+    y    = boolector_var (d_btor, s, "y");
+    prod = boolector_mul (d_btor, x, y);
+    assert_binary (boolector_eq, prod, 143);
+    assert_binary (boolector_ugt, x, 1);
+    assert_binary (boolector_ugt, y, 1);
+    assert_binary (boolector_ult, x, 20);
+    assert_binary (boolector_ult, y, 20);
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    ASSERT_EQ (get_value (x) * get_value (y), 143u);
+
+    boolector_release (d_btor, prod);
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, y);
+    boolector_release_sort (d_btor, s);
+  }
+};
+
+TEST_F (TestPreseed, sat_preprop) { test_factor (BTOR_OPT_FUN_PREPROP); }
+
+TEST_F (TestPreseed, sat_presls) { test_factor (BTOR_OPT_FUN_PRESLS); }
+
+/* the seeded phases must not affect unsatisfiability */
+TEST_F (TestPreseed, unsat_preprop)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *sum;
+
+  boolector_set_opt (d_btor, BTOR_OPT_FUN_PREPROP, 1);
+
+  s   = boolector_bitvec_sort (d_btor, 16);
+  x   = boolector_var (d_btor, s, "x");
+  y   = boolector_var (d_btor, s, "y");
+  sum = boolector_add (d_btor, x, y);
+  assert_binary (boolector_eq, sum, 1000);
+  assert_binary (boolector_ult, x, 5);
+  assert_binary (boolector_ult, y, 900);
+  ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_UNSAT);
+
+  boolector_release (d_btor, sum);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release_sort (d_btor, s);
+}
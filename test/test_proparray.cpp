@@ -0,0 +1,189 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+#include "btorslv.h"
+}
+
+class TestPropArray : public TestBoolector
+{
+ protected:
+  void SetUp () override
+  {
+    TestBoolector::SetUp ();
+    boolector_set_opt (d_btor, BTOR_OPT_ENGINE, BTOR_ENGINE_PROP);
+    boolector_set_opt (d_btor, BTOR_OPT_MODEL_GEN, 1);
+    d_bv8  = boolector_bitvec_sort (d_btor, 8);
+    d_arr8 = boolector_array_sort (d_btor, d_bv8, d_bv8);
+  }
+
+  void TearDown () override
+  {
+    boolector_release_sort (d_btor, d_arr8);
+    boolector_release_sort (d_btor, d_bv8);
+    TestBoolector::TearDown ();
+  }
+
+  BoolectorNode *constant (uint32_t val)
+  {
+    return boolector_unsigned_int (d_btor, val, d_bv8);
+  }
+
+  void assert_eq (BoolectorNode *a, BoolectorNode *b)
+  {
+    BoolectorNode *n = boolector_eq (d_btor, a, b);
+    boolector_assert (d_btor, n);
+    boolector_release (d_btor, n);
+  }
+
+  void assert_eq (BoolectorNode *a, uint32_t b)
+  {
+    BoolectorNode *c = constant (b);
+    assert_eq (a, c);
+    boolector_release (d_btor, c);
+  }
+
+  uint64_t get_value (BoolectorNode *n)
+  {
+    const char *bits = boolector_bv_assignment (d_btor, n);
+    uint64_t res     = strtoull (bits, 0, 2);
+    boolector_free_bv_assignment (d_btor, bits);
+    return res;
+  }
+
+  void check_sat ()
+  {
+    ASSERT_EQ (boolector_sat (d_btor), BOOLECTOR_SAT);
+    ASSERT_EQ (d_btor->slv->kind, BTOR_PROP_SOLVER_KIND);
+  }
+
+  BoolectorSort d_bv8  = nullptr;
+  BoolectorSort d_arr8 = nullptr;
+};
+
+TEST_F (TestPropArray, select)
+{
+  BoolectorNode *a, *i, *j, *ai, *aj, *one, *ip1;
+
+  a   = boolector_array (d_btor, d_arr8, "a");
+  i   = boolector_var (d_btor, d_bv8, "i");
+  j   = boolector_var (d_btor, d_bv8, "j");
+  one = constant (1);
+  ip1 = boolector_add (d_btor, i, one);
+  ai  = boolector_read (d_btor, a, i);
+  aj  = boolector_read (d_btor, a, ip1);
+  assert_eq (ai, 7);
+  assert_eq (aj, 9);
+  assert_eq (j, ip1);
+  check_sat ();
+  ASSERT_EQ (get_value (ai), 7u);
+  ASSERT_EQ (get_value (aj), 9u);
+  ASSERT_EQ (get_value (j), (get_value (i) + 1) % 256);
+
+  boolector_release (d_btor, aj);
+  boolector_release (d_btor, ai);
+  boolector_release (d_btor, ip1);
+  boolector_release (d_btor, one);
+  boolector_release (d_btor, j);
+  boolector_release (d_btor, i);
+  boolector_release (d_btor, a);
+}
+
+TEST_F (TestPropArray, store)
+{
+  BoolectorNode *a, *i, *j, *v, *st, *rd, *ne, *ugt, *c;
+
+  a   = boolector_array (d_btor, d_arr8, "a");
+  i   = boolector_var (d_btor, d_bv8, "i");
+  j   = boolector_var (d_btor, d_bv8, "j");
+  v   = boolector_var (d_btor, d_bv8, "v");
+  st  = boolector_write (d_btor, a, i, v);
+  rd  = boolector_read (d_btor, st, j);
+  c   = constant (100);
+  ugt = boolector_ugt (d_btor, rd, c);
+  ne  = boolector_ne (d_btor, v, rd);
+  boolector_assert (d_btor, ugt);
+  boolector_assert (d_btor, ne);
+  check_sat ();
+  ASSERT_GT (get_value (rd), 100u);
+  ASSERT_NE (get_value (i), get_value (j));
+
+  boolector_release (d_btor, ne);
+  boolector_release (d_btor, ugt);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, rd);
+  boolector_release (d_btor, st);
+  boolector_release (d_btor, v);
+  boolector_release (d_btor, j);
+  boolector_release (d_btor, i);
+  boolector_release (d_btor, a);
+}
+
+TEST_F (TestPropArray, cond)
+{
+  BoolectorSort s;
+  BoolectorNode *a, *b, *c, *i, *ite, *rd, *rdb;
+
+  s   = boolector_bool_sort (d_btor);
+  a   = boolector_array (d_btor, d_arr8, "a");
+  b   = boolector_array (d_btor, d_arr8, "b");
+  c   = boolector_var (d_btor, s, "c");
+  i   = boolector_var (d_btor, d_bv8, "i");
+  ite = boolector_cond (d_btor, c, a, b);
+  rd  = boolector_read (d_btor, ite, i);
+  rdb = boolector_read (d_btor, b, i);
+  assert_eq (rd, 42);
+  assert_eq (rdb, 3);
+  check_sat ();
+  ASSERT_EQ (get_value (c), 1u);
+  ASSERT_EQ (get_value (rd), 42u);
+
+  boolector_release (d_btor, rdb);
+  boolector_release (d_btor, rd);
+  boolector_release (d_btor, ite);
+  boolector_release (d_btor, i);
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, b);
+  boolector_release (d_btor, a);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestPropArray, uf)
+{
+  BoolectorSort dom[2], s;
+  BoolectorNode *f, *x, *y, *fxy, *fyx, *args[2];
+
+  dom[0] = d_bv8;
+  dom[1] = d_bv8;
+  s      = boolector_fun_sort (d_btor, dom, 2, d_bv8);
+  f      = boolector_uf (d_btor, s, "f");
+  x      = boolector_var (d_btor, d_bv8, "x");
+  y      = boolector_var (d_btor, d_bv8, "y");
+
+  args[0] = x;
+  args[1] = y;
+  fxy     = boolector_apply (d_btor, args, 2, f);
+  args[0] = y;
+  args[1] = x;
+  fyx     = boolector_apply (d_btor, args, 2, f);
+  assert_eq (fxy, 42);
+  assert_eq (fyx, 17);
+  check_sat ();
+  ASSERT_NE (get_value (x), get_value (y));
+  ASSERT_EQ (get_value (fxy), 42u);
+  ASSERT_EQ (get_value (fyx), 17u);
+
+  boolector_release (d_btor, fyx);
+  boolector_release (d_btor, fxy);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, f);
+  boolector_release_sort (d_btor, s);
+}
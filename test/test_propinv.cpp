@@ -1614,3 +1614,73 @@ TEST_F (TestPropInv, conf_concat)
   check_conf_concat (4);
   check_conf_concat (8);
 }
+
+/* ------------------------------------------------------------------------ */
+/* inverse value cache                                                      */
+/* ------------------------------------------------------------------------ */
+
+TEST_F (TestPropInv, inv_cache_mul)
+{
+#ifndef NDEBUG
+  uint32_t bw;
+  BtorNode *mul, *e[2];
+  BtorSortId sort;
+  BtorBitVector *bvmul, *bve, *res1, *res2, *tmp;
+  BtorPropSolver *slv;
+
+  bw   = 8;
+  sort = btor_sort_bv (d_btor, bw);
+  e[0] = btor_exp_var (d_btor, sort, 0);
+  e[1] = btor_exp_var (d_btor, sort, 0);
+  btor_sort_release (d_btor, sort);
+  mul = btor_exp_bv_mul (d_btor, e[0], e[1]);
+
+  slv            = BTOR_PROP_SOLVER (d_btor);
+  slv->inv_cache = btor_proputils_inv_cache_new (d_mm);
+
+  /* bve odd: unique inverse value */
+  bvmul = btor_bv_uint64_to_bv (d_mm, 143, bw);
+  bve   = btor_bv_uint64_to_bv (d_mm, 11, bw);
+  res1  = inv_mul_bv (d_btor, mul, bvmul, bve, 1);
+  ASSERT_EQ (slv->stats.inv_cache_hits, 0u);
+  res2 = inv_mul_bv (d_btor, mul, bvmul, bve, 1);
+  ASSERT_EQ (slv->stats.inv_cache_hits, 1u);
+  ASSERT_EQ (btor_bv_to_uint64 (res1), 13u);
+  ASSERT_EQ (btor_bv_compare (res1, res2), 0);
+  btor_bv_free (d_mm, res1);
+  btor_bv_free (d_mm, res2);
+  btor_bv_free (d_mm, bve);
+
+  /* bvmul odd, bve even: conflicts are cached */
+  bve  = btor_bv_uint64_to_bv (d_mm, 6, bw);
+  res1 = inv_mul_bv (d_btor, mul, bvmul, bve, 1);
+  res2 = inv_mul_bv (d_btor, mul, bvmul, bve, 1);
+  ASSERT_EQ (slv->stats.inv_cache_hits, 2u);
+  ASSERT_EQ (slv->stats.rec_conf, 2u);
+  btor_bv_free (d_mm, res1);
+  btor_bv_free (d_mm, res2);
+  btor_bv_free (d_mm, bvmul);
+
+  /* bve even: cached values are completed with random bits */
+  bvmul = btor_bv_uint64_to_bv (d_mm, 18, bw);
+  res1  = inv_mul_bv (d_btor, mul, bvmul, bve, 1);
+  res2  = inv_mul_bv (d_btor, mul, bvmul, bve, 1);
+  ASSERT_EQ (slv->stats.inv_cache_hits, 3u);
+  tmp = btor_bv_mul (d_mm, bve, res1);
+  ASSERT_EQ (btor_bv_compare (tmp, bvmul), 0);
+  btor_bv_free (d_mm, tmp);
+  tmp = btor_bv_mul (d_mm, bve, res2);
+  ASSERT_EQ (btor_bv_compare (tmp, bvmul), 0);
+  btor_bv_free (d_mm, tmp);
+  btor_bv_free (d_mm, res1);
+  btor_bv_free (d_mm, res2);
+  btor_bv_free (d_mm, bvmul);
+  btor_bv_free (d_mm, bve);
+
+  btor_proputils_inv_cache_delete (slv->inv_cache);
+  slv->inv_cache = 0;
+  btor_node_release (d_btor, e[0]);
+  btor_node_release (d_btor, e[1]);
+  btor_node_release (d_btor, mul);
+#endif
+}
@@ -0,0 +1,152 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorrewrite.h"
+}
+
+class TestRewrite : public TestBoolector
+{
+ protected:
+  uint_least64_t num_applied ()
+  {
+    uint_least64_t res = 0;
+    for (uint32_t i = 0; i < BTOR_RW_NUM_RULES; i++)
+      res += d_btor->stats.rw_rules[i].applied;
+    return res;
+  }
+
+  uint_least64_t num_attempts ()
+  {
+    uint_least64_t res = 0;
+    for (uint32_t i = 0; i < BTOR_RW_NUM_RULES; i++)
+      res += d_btor->stats.rw_rules[i].attempts;
+    return res;
+  }
+
+  void mk_and_chain ()
+  {
+    BoolectorSort s;
+    BoolectorNode *x, *y, *a0, *a1, *a2;
+
+    s  = boolector_bitvec_sort (d_btor, 8);
+    x  = boolector_var (d_btor, s, "x");
+    y  = boolector_var (d_btor, s, "y");
+    a0 = boolector_and (d_btor, x, y);
+    a1 = boolector_and (d_btor, a0, x);
+    a2 = boolector_and (d_btor, a1, y);
+    boolector_release (d_btor, x);
+    boolector_release (d_btor, y);
+    boolector_release (d_btor, a0);
+    boolector_release (d_btor, a1);
+    boolector_release (d_btor, a2);
+    boolector_release_sort (d_btor, s);
+  }
+};
+
+TEST_F (TestRewrite, profile_disabled)
+{
+  mk_and_chain ();
+  ASSERT_EQ (num_attempts (), 0u);
+  ASSERT_EQ (num_applied (), 0u);
+}
+
+TEST_F (TestRewrite, profile)
+{
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_PROFILE, 1);
+  mk_and_chain ();
+  ASSERT_GT (num_attempts (), 0u);
+  ASSERT_GT (num_applied (), 0u);
+  ASSERT_LE (num_applied (), num_attempts ());
+  ASSERT_GT (d_btor->stats.rw_rules[BTOR_RW_RULE_contr_rec_and].attempts, 0u);
+
+  boolector_reset_stats (d_btor);
+  ASSERT_EQ (num_attempts (), 0u);
+}
+
+TEST_F (TestRewrite, profile_json)
+{
+  char *buf;
+  size_t size;
+  FILE *file;
+  std::string json;
+
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_PROFILE, 2);
+  mk_and_chain ();
+
+  file = open_memstream (&buf, &size);
+  boolector_print_rewrite_profile (d_btor, file);
+  fclose (file);
+  json = buf;
+  free (buf);
+
+  ASSERT_EQ (json.front (), '{');
+  ASSERT_NE (json.find ("\"rules\": ["), std::string::npos);
+  ASSERT_NE (json.find ("\"rule\": \"contr_rec_and\""), std::string::npos);
+}
+
+TEST_F (TestRewrite, cand_skip)
+{
+  BoolectorSort s;
+  BoolectorNode *x, *y, *c0, *c1, *a0, *a1;
+
+  boolector_set_opt (d_btor, BTOR_OPT_REWRITE_PROFILE, 1);
+
+  s  = boolector_bitvec_sort (d_btor, 8);
+  x  = boolector_var (d_btor, s, "x");
+  y  = boolector_var (d_btor, s, "y");
+  a0 = boolector_and (d_btor, x, y);
+  /* rules that require constant operands are never attempted */
+  ASSERT_EQ (d_btor->stats.rw_rules[BTOR_RW_RULE_const_binary_exp].attempts,
+             0u);
+  ASSERT_EQ (d_btor->stats.rw_rules[BTOR_RW_RULE_const1_and].attempts, 0u);
+  ASSERT_EQ (d_btor->stats.rw_rules[BTOR_RW_RULE_idem1_and].attempts, 0u);
+  ASSERT_GT (d_btor->stats.rw_rules[BTOR_RW_RULE_contr_rec_and].attempts, 0u);
+
+  c0 = boolector_int (d_btor, 3, s);
+  c1 = boolector_int (d_btor, 5, s);
+  a1 = boolector_and (d_btor, c0, c1);
+  ASSERT_EQ (d_btor->stats.rw_rules[BTOR_RW_RULE_const_binary_exp].attempts,
+             1u);
+  ASSERT_EQ (d_btor->stats.rw_rules[BTOR_RW_RULE_const_binary_exp].applied,
+             1u);
+
+  boolector_release (d_btor, x);
+  boolector_release (d_btor, y);
+  boolector_release (d_btor, c0);
+  boolector_release (d_btor, c1);
+  boolector_release (d_btor, a0);
+  boolector_release (d_btor, a1);
+  boolector_release_sort (d_btor, s);
+}
+
+TEST_F (TestRewrite, fixpoint_deep)
+{
+  uint32_t i, n = 6000;
+  BoolectorSort s;
+  BoolectorNode *c, *t, *v, *sl;
+
+  s = boolector_bitvec_sort (d_btor, 1);
+  c = boolector_var (d_btor, s, 0);
+  for (i = 1; i < n; i++)
+  {
+    v = boolector_var (d_btor, s, 0);
+    t = boolector_concat (d_btor, c, v);
+    boolector_release (d_btor, c);
+    boolector_release (d_btor, v);
+    c = t;
+  }
+  /* slicing the chain exceeds the recursive rewriting bound */
+  sl = boolector_slice (d_btor, c, n - 2, 1);
+  ASSERT_GT (d_btor->stats.rw_fixpoint_passes, 0u);
+  ASSERT_EQ (d_btor->ops[BTOR_BV_SLICE_NODE].cur, 0u);
+
+  boolector_release (d_btor, c);
+  boolector_release (d_btor, sl);
+  boolector_release_sort (d_btor, s);
+}
@@ -0,0 +1,156 @@
+/*  Boolector: Satisfiability Modulo Theories (SMT) solver.
+ *
+ *  This file is part of Boolector.
+ *  See COPYING for more information on using this software.
+ */
+
+#include "test.h"
+
+extern "C" {
+#include "btorcore.h"
+#include "btoropt.h"
+#include "btorslvsls.h"
+}
+
+class TestSlsLanes : public TestCommon
+{
+ protected:
+  struct Run
+  {
+    int32_t result;
+    uint32_t flips;
+    uint32_t moves;
+    uint32_t lanes;
+    std::string x;
+  };
+
+  void assert_binary (Btor *btor,
+                      BoolectorNode *(*fun) (Btor *,
+                                             BoolectorNode *,
+                                             BoolectorNode *),
+                      BoolectorNode *a,
+                      uint32_t b)
+  {
+    BoolectorNode *c, *n;
+    c = boolector_unsigned_int (btor, b, boolector_get_sort (btor, a));
+    n = fun (btor, a, c);
+    boolector_assert (btor, n);
+    boolector_release (btor, n);
+    boolector_release (btor, c);
+  }
+
+  /* x * y = 143 with 1 < x, y < 20 */
+  void mk_factor (Btor *btor, BoolectorNode *x, BoolectorNode *y)
+  {
+    BoolectorNode *prod = boolector_mul (btor, x, y);
+    assert_binary (btor, boolector_eq, prod, 143);
+    assert_binary (btor, boolector_ugt, x, 1);
+    assert_binary (btor, boolector_ugt, y, 1);
+    assert_binary (btor, boolector_ult, x, 20);
+    assert_binary (btor, boolector_ult, y, 20);
+    boolector_release (btor, prod);
+  }
+
+  /* uses all operators that are evaluated bit-parallel */
+  void mk_ops (Btor *btor, BoolectorNode *x, BoolectorNode *y)
+  {
+    BoolectorNode *div, *rem, *sll, *srl, *cat, *slc, *ite, *lt, *sum;
+
+    div = boolector_udiv (btor, x, y);
+    rem = boolector_urem (btor, x, y);
+    sll = boolector_sll (btor, x, y);
+    srl = boolector_srl (btor, y, x);
+    slc = boolector_slice (btor, x, 3, 0);
+    cat = boolector_concat (btor, slc, div);
+    lt  = boolector_ult (btor, sll, srl);
+    ite = boolector_cond (btor, lt, rem, div);
+    sum = boolector_add (btor, ite, y);
+    assert_binary (btor, boolector_eq, sum, 77);
+    assert_binary (btor, boolector_ugt, cat, 1000);
+    assert_binary (btor, boolector_ne, rem, 0);
+
+    boolector_release (btor, sum);
+    boolector_release (btor, ite);
+    boolector_release (btor, lt);
+    boolector_release (btor, cat);
+    boolector_release (btor, slc);
+    boolector_release (btor, srl);
+    boolector_release (btor, sll);
+    boolector_release (btor, rem);
+    boolector_release (btor, div);
+  }
+
+  Run run (bool ops, uint32_t width, uint32_t lanes, uint32_t nflips)
+  {
+    Btor *btor;
+    BoolectorSort s;
+    BoolectorNode *x, *y;
+    BtorSLSSolver *slv;
+    const char *bits;
+    Run res;
+
+    btor = boolector_new ();
+    boolector_set_opt (btor, BTOR_OPT_ENGINE, BTOR_ENGINE_SLS);
+    boolector_set_opt (btor, BTOR_OPT_MODEL_GEN, 1);
+    boolector_set_opt (btor, BTOR_OPT_SLS_MOVE_LANES, lanes);
+    boolector_set_opt (btor, BTOR_OPT_SLS_NFLIPS, nflips);
+
+    s = boolector_bitvec_sort (btor, width);
+    x = boolector_var (btor, s, "x");
+    y = boolector_var (btor, s, "y");
+    if (ops)
+      mk_ops (btor, x, y);
+    else
+      mk_factor (btor, x, y);
+
+    res.result = boolector_sat (btor);
+    EXPECT_EQ (btor->slv->kind, BTOR_SLS_SOLVER_KIND);
+    slv       = BTOR_SLS_SOLVER (btor);
+    res.flips = slv->stats.flips;
+    res.moves = slv->stats.moves;
+    res.lanes = slv->stats.lanes;
+    if (res.result == BOOLECTOR_SAT)
+    {
+      bits  = boolector_bv_assignment (btor, x);
+      res.x = bits;
+      boolector_free_bv_assignment (btor, bits);
+    }
+
+    boolector_release (btor, x);
+    boolector_release (btor, y);
+    boolector_release_sort (btor, s);
+    boolector_delete (btor);
+    return res;
+  }
+
+  /* bit-parallel and sequential neighborhood exploration must perform the
+   * same moves */
+  void test_same (bool ops, uint32_t width, uint32_t nflips)
+  {
+    Run seq = run (ops, width, 0, nflips);
+    Run par = run (ops, width, 1, nflips);
+
+    ASSERT_EQ (seq.result, par.result);
+    ASSERT_EQ (seq.flips, par.flips);
+    ASSERT_EQ (seq.moves, par.moves);
+    ASSERT_EQ (seq.x, par.x);
+    ASSERT_EQ (seq.lanes, 0u);
+    ASSERT_GT (par.lanes, 0u);
+  }
+};
+
+TEST_F (TestSlsLanes, factor8) { test_same (false, 8, 0); }
+
+TEST_F (TestSlsLanes, factor16) { test_same (false, 16, 0); }
+
+TEST_F (TestSlsLanes, factor64) { test_same (false, 64, 0); }
+
+TEST_F (TestSlsLanes, ops) { test_same (true, 8, 5000); }
+
+/* nodes wider than 64 bits are not evaluated bit-parallel */
+TEST_F (TestSlsLanes, wide)
+{
+  Run par = run (false, 72, 1, 0);
+  ASSERT_EQ (par.result, BOOLECTOR_SAT);
+  ASSERT_EQ (par.lanes, 0u);
+}